@@ -1,8 +1,11 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/parallel.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <ranges>
+#include <string_view>
 
 struct d05 {
   static std::string convert(const std::string &input) {
@@ -24,18 +27,18 @@ struct d05 {
   }
 
   static size_t part2(const std::string &input) {
-    size_t min = std::numeric_limits<size_t>::max();
-    for (char to_remove : "ABCDEFGHIJKLMNOPQRSTUVWXYZ") {
-      std::string modified = input;
-      auto removed = std::erase_if(modified, [to_remove](char c) {
-        return c == to_remove || (c - ('a' - 'A')) == to_remove;
-      });
-      if (removed == 0) {
-        continue;
-      }
-      min = std::min(min, part1(std::move(modified)));
-    }
-    return min;
+    constexpr auto none = std::numeric_limits<size_t>::max();
+    // Each type of unit is removed from its own copy of the polymer
+    return aoc::parallel_transform_reduce(
+        std::string_view("ABCDEFGHIJKLMNOPQRSTUVWXYZ"), none,
+        [](size_t l, size_t r) { return std::min(l, r); },
+        [&input](char to_remove) {
+          std::string modified = input;
+          auto removed = std::erase_if(modified, [to_remove](char c) {
+            return c == to_remove || (c - ('a' - 'A')) == to_remove;
+          });
+          return removed == 0 ? none : part1(std::move(modified));
+        });
   }
 };
 
@@ -57,4 +60,10 @@ TEST(d05, part1) {
 
 TEST(d05, part2) { EXPECT_EQ(d05::part2("dabAcCaCBAcCcaDA"), 4); }
 
+TEST(d05, part2_threads) {
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  EXPECT_EQ(d05::part2("dabAcCaCBAcCcaDA"), 4);
+}
+
 #endif
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/geometry/point_array.hpp>
+#include <aoc_lib/parallel.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <algorithm>
@@ -6,55 +8,21 @@
 #include <ranges>
 #include <set>
 #include <stdexcept>
-#include <unordered_map>
 #include <vector>
 
-struct point {
-  int64_t x;
-  int64_t y;
-};
-
-int64_t manhattan_distance(const point &l, const point &r) {
-  return std::abs(l.x - r.x) + std::abs(l.y - r.y);
-}
-
-class closest_point_accumulator {
-public:
-  void accumulate(int64_t id, int64_t dist) {
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest = id;
-    } else if (dist == min_dist) {
-      closest = std::nullopt;
-    }
-  }
-
-  std::optional<int64_t> get_closest() const { return closest; }
-
-private:
-  std::optional<int64_t> closest;
-  int64_t min_dist = std::numeric_limits<int64_t>::max();
-};
-
-std::optional<int64_t>
-closest_point(const point &from, const std::ranges::input_range auto &range) {
-  closest_point_accumulator acc;
-  for (const auto &[i, d] : range | std::views::enumerate) {
-    acc.accumulate(i, manhattan_distance(from, d));
-  }
-  return acc.get_closest();
-}
+using point_t = aoc::point2d<int64_t>;
+using points_t = aoc::point_array<int64_t, 2>;
 
 struct d06 {
   struct data {
-    std::vector<point> points;
+    points_t points;
     std::int64_t part2_dist;
   };
 
   static data convert(const aoc::arguments &args) {
     return data{
         .points =
-            std::vector{
+            points_t{
                 std::from_range,
                 aoc::lines(aoc::trimmed(args.input)) |
                     std::views::transform([](std::string_view line) {
@@ -63,7 +31,7 @@ struct d06 {
                         throw std::runtime_error(
                             std::format("Failed to parse line {}", line));
                       }
-                      return point{
+                      return point_t{
                           *aoc::from_chars<int64_t>(line.substr(0, comma)),
                           *aoc::from_chars<int64_t>(line.substr(comma + 2))};
                     })},
@@ -71,75 +39,71 @@ struct d06 {
   }
 
   static std::pair<int64_t, int64_t> run(const data &d) {
-    auto top_left = point{std::numeric_limits<int64_t>::max(),
-                          std::numeric_limits<int64_t>::max()};
-    auto bottom_right = point{0, 0};
-    for (const auto &[x, y] : d.points) {
-      top_left.x = std::min(top_left.x, x);
-      top_left.y = std::min(top_left.y, y);
-      bottom_right.x = std::max(bottom_right.x, x);
-      bottom_right.y = std::max(bottom_right.y, y);
-    }
+    const auto [left, right] = std::ranges::minmax(d.points.coordinates(0));
+    const auto [top, bottom] = std::ranges::minmax(d.points.coordinates(1));
+    auto closest_point = [&d](int64_t x, int64_t y) {
+      return d.points.unique_nearest({x, y}, aoc::metric::manhattan);
+    };
 
     // Remove infinit areas
     // Walk the perimeter, any one closest has infinite area
-    std::set<int64_t> infinites;
+    std::set<size_t> infinites;
     // Horizontal edges
-    for (auto [top, bottom] :
-         std::views::iota(top_left.x, bottom_right.x + 1) |
-             std::views::transform([&](int64_t x) {
-               return std::make_pair(
-                   closest_point({x, top_left.y}, d.points),
-                   closest_point({x, bottom_right.y}, d.points));
-             })) {
-      if (top)
-        infinites.insert(*top);
-      if (bottom)
-        infinites.insert(*bottom);
+    for (int64_t x = left; x <= right; ++x) {
+      if (auto closest = closest_point(x, top))
+        infinites.insert(*closest);
+      if (auto closest = closest_point(x, bottom))
+        infinites.insert(*closest);
     }
     // Vertical edges
-    for (auto [left, right] :
-         std::views::iota(top_left.y, bottom_right.y + 1) |
-             std::views::transform([&](int64_t y) {
-               return std::make_pair(
-                   closest_point({top_left.x, y}, d.points),
-                   closest_point({bottom_right.x, y}, d.points));
-             })) {
-      if (left)
-        infinites.insert(*left);
-      if (right)
-        infinites.insert(*right);
+    for (int64_t y = top; y <= bottom; ++y) {
+      if (auto closest = closest_point(left, y))
+        infinites.insert(*closest);
+      if (auto closest = closest_point(right, y))
+        infinites.insert(*closest);
     }
 
-    // Compute areas
-    std::unordered_map<std::size_t, std::size_t> areas;
-    int64_t center_area = 0;
-
-    for (int64_t x = top_left.x; x <= bottom_right.x; ++x) {
-      for (int64_t y = top_left.y; y <= bottom_right.y; ++y) {
-        closest_point_accumulator acc;
-        int64_t dist_sum = 0;
-        for (const auto &[i, p] : d.points | std::views::enumerate) {
-          auto dist = manhattan_distance(point{x, y}, p);
-          acc.accumulate(i, dist);
-          dist_sum += dist;
-        }
-        if (auto closest = acc.get_closest()) {
-          areas[*closest] += 1;
-        }
-        if (dist_sum < d.part2_dist) {
-          center_area += 1;
-        }
-      }
-    }
+    // Compute areas, columns in parallel
+    struct tally_t {
+      std::vector<size_t> areas;
+      int64_t center_area = 0;
+    };
+    auto empty_tally = [&d] {
+      return tally_t{.areas = std::vector<size_t>(d.points.size())};
+    };
+    const auto tally = aoc::parallel_transform_reduce(
+        std::views::iota(left, right + 1), empty_tally(),
+        [](tally_t l, const tally_t &r) {
+          for (size_t i = 0; i < l.areas.size(); ++i) {
+            l.areas[i] += r.areas[i];
+          }
+          l.center_area += r.center_area;
+          return l;
+        },
+        [&](int64_t x) {
+          tally_t column = empty_tally();
+          for (int64_t y = top; y <= bottom; ++y) {
+            const auto [closest, sum] =
+                d.points.unique_nearest_and_sum({x, y}, aoc::metric::manhattan);
+            if (closest) {
+              column.areas[*closest] += 1;
+            }
+            if (sum < d.part2_dist) {
+              column.center_area += 1;
+            }
+          }
+          return column;
+        });
 
     return std::make_pair(
-        std::ranges::max(areas |
-                         std::views::filter([&infinites](const auto &entry) {
-                           return !infinites.contains(entry.first);
+        std::ranges::max(std::views::iota(size_t{0}, tally.areas.size()) |
+                         std::views::filter([&infinites](size_t i) {
+                           return !infinites.contains(i);
                          }) |
-                         std::views::values),
-        center_area);
+                         std::views::transform([&tally](size_t i) {
+                           return tally.areas[i];
+                         })),
+        tally.center_area);
   }
 };
 
@@ -1,13 +1,26 @@
 #include <aoc_lib/algorithm.hpp>
+#include <aoc_lib/arena.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/small_vector.hpp>
 #include <aoc_lib/string.hpp>
 
+#include <memory>
+#include <memory_resource>
 #include <ranges>
+#include <stdexcept>
 #include <vector>
 
+// Nodes come by the thousands: their children are allocated from the arena of
+// their tree, and their few metadata entries are stored inline.
 struct node {
-  std::vector<node> children;
-  std::vector<size_t> metadata;
+  std::pmr::vector<node> children;
+  aoc::small_vector<size_t, 4> metadata;
+};
+
+// Declared first, the arena outlives the nodes allocated from it
+struct tree {
+  std::unique_ptr<aoc::arena> memory;
+  node root;
 };
 
 size_t get_next(auto &it, auto end) {
@@ -17,13 +30,15 @@ size_t get_next(auto &it, auto end) {
   return *it++;
 }
 
-node parse_node(auto &it, auto end) {
+node parse_node(auto &it, auto end, std::pmr::memory_resource *memory) {
   size_t child_size = get_next(it, end);
   size_t metadata_size = get_next(it, end);
-  node res;
+  node res{.children = std::pmr::vector<node>(memory), .metadata = {}};
 
+  res.children.reserve(child_size);
+  res.metadata.reserve(metadata_size);
   for (size_t i = 0; i < child_size; ++i) {
-    res.children.push_back(parse_node(it, end));
+    res.children.push_back(parse_node(it, end, memory));
   }
   for (size_t i = 0; i < metadata_size; ++i) {
     res.metadata.push_back(get_next(it, end));
@@ -32,22 +47,24 @@ node parse_node(auto &it, auto end) {
 }
 
 struct d08 {
-  static node convert(std::string_view input) {
+  static tree convert(std::string_view input) {
     auto range =
         input | std::views::split(' ') |
         std::views::transform([](auto subrange) {
           return aoc::from_chars<size_t>(std::string_view(subrange)).value();
         });
     auto begin = std::ranges::begin(range);
-    return parse_node(begin, std::ranges::end(range));
+    auto memory = std::make_unique<aoc::arena>();
+    node root = parse_node(begin, std::ranges::end(range), memory.get());
+    return tree{.memory = std::move(memory), .root = std::move(root)};
   }
 
-  static size_t part1(const node &n) {
-    return *aoc::sum(n.children | std::views::transform(&part1)) +
+  static size_t metadata_sum(const node &n) {
+    return *aoc::sum(n.children | std::views::transform(&metadata_sum)) +
            *aoc::sum(n.metadata);
   }
 
-  static size_t part2(const node &n) {
+  static size_t value(const node &n) {
     if (n.children.empty()) {
       return *aoc::sum(n.metadata);
     }
@@ -56,9 +73,13 @@ struct d08 {
                        if (idx == 0 || idx > n.children.size()) {
                          return 0;
                        }
-                       return part2(n.children[idx - 1]);
+                       return value(n.children[idx - 1]);
                      }));
   }
+
+  static size_t part1(const tree &t) { return metadata_sum(t.root); }
+
+  static size_t part2(const tree &t) { return value(t.root); }
 };
 
 #ifndef TESTING
@@ -79,4 +100,12 @@ const auto test_data =
 TEST(d08, part1) { EXPECT_EQ(aoc::part1<d08>(test_data), 138); }
 TEST(d08, part2) { EXPECT_EQ(aoc::part2<d08>(test_data), 66); }
 
+TEST(d08, children_in_arena) {
+  const tree t = d08::convert(test_data.input);
+  EXPECT_GT(t.memory->allocated(), size_t{0});
+  EXPECT_EQ(t.root.children.get_allocator().resource(), t.memory.get());
+  EXPECT_EQ(t.root.children[0].children.get_allocator().resource(),
+            t.memory.get());
+}
+
 #endif
\ No newline at end of file
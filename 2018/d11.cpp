@@ -5,11 +5,11 @@
 
 #include <format>
 
-using data = aoc::dyn_matrix<int64_t>;
+using data = aoc::prefix_sum_2d<int64_t>;
 
 struct d11 {
-  static data make_grid(std::string_view input) {
-    data grid(300, 300);
+  static aoc::dyn_matrix<int64_t> make_grid(std::string_view input) {
+    auto grid = aoc::dyn_matrix<int64_t>(300, 300);
     auto serial = *aoc::from_chars<int64_t>(aoc::trimmed(input));
 
     for (uint64_t y = 0; y < 300; ++y) {
@@ -21,85 +21,17 @@ struct d11 {
     return grid;
   }
 
-  static data convert(std::string_view input) {
-    data result = make_grid(input);
-
-    for (uint64_t y = 0; y < result.height(); ++y) {
-      for (uint64_t x = 0; x < result.width(); ++x) {
-        auto &local_sum = result[y, x];
-        if (x > 0) {
-          local_sum += result[y, static_cast<size_t>(x - 1)];
-        }
-        if (y > 0) {
-          local_sum += result[static_cast<size_t>(y - 1), x];
-        }
-        if (x > 0 && y > 0) {
-          local_sum -=
-              result[static_cast<size_t>(y - 1), static_cast<size_t>(x - 1)];
-        }
-      }
-    }
-
-    return result;
-  }
-
-  static std::pair<int64_t, aoc::point2d<uint64_t>>
-  find_max_square(const data &d, aoc::point2d<uint64_t> start,
-                  uint64_t square_size, uint64_t search_size) {
-    return std::ranges::max(
-        // for each points
-        std::views::iota(uint64_t(start.x()),
-                         uint64_t(start.x() + square_size - search_size + 1)) |
-            std::views::transform([start, square_size,
-                                   search_size](uint64_t x) {
-              return std::views::iota(
-                         uint64_t(start.y()),
-                         uint64_t(start.y() + square_size - search_size + 1)) |
-                     std::views::transform([x](uint64_t y) {
-                       return aoc::point2d<uint64_t>{x, y};
-                     });
-            }) |
-            std::views::join |
-            // map to pair of [SxS sum, point]
-            std::views::transform([&d,
-                                   search_size](aoc::point2d<uint64_t> point) {
-              auto delta = static_cast<uint64_t>(search_size - 1);
-              auto sum = d[point.y() + delta, point.x() + delta];
-              if (point.x() > 0) {
-                sum -= d[point.y() + delta, static_cast<size_t>(point.x() - 1)];
-              }
-              if (point.y() > 0) {
-                sum -= d[static_cast<size_t>(point.y() - 1), point.x() + delta];
-              }
-              if (point.x() > 0 && point.y() > 0) {
-                sum += d[static_cast<size_t>(point.y() - 1),
-                         static_cast<size_t>(point.x() - 1)];
-              }
-
-              return std::make_pair(sum, point);
-            }),
-        {}, [](const auto &pair) { return pair.first; });
-  }
+  static data convert(std::string_view input) { return data(make_grid(input)); }
 
   static std::string part1(const data &d) {
-    auto [sum, top_left] = find_max_square(d, {0, 0}, 300, 3);
-    uint64_t search_size = 3;
-    aoc::point2d<uint64_t> point{20, 60};
-    aoc::point2d<uint64_t> point2 =
-        point + aoc::vector2d<uint64_t>{search_size - 1, search_size - 1};
-    return std::format("{},{}", top_left.x() + 1, top_left.y() + 1);
+    auto best = d.best_window(3).value();
+    return std::format("{},{}", best.top_left.x() + 1, best.top_left.y() + 1);
   }
 
   static std::string part2(const data &d) {
-    auto [sum, point, size] =
-        std::ranges::max(std::views::iota(uint64_t(1), uint64_t(301)) |
-                             std::views::transform([&d](uint64_t size) {
-                               auto [sum, point] =
-                                   find_max_square(d, {0, 0}, 300, size);
-                               return std::make_tuple(sum, point, size);
-                             }),
-                         {}, [](const auto &t) { return std::get<0>(t); });
-    return std::format("{},{},{}", point.x() + 1, point.y() + 1, size);
+    auto best = d.best_window(1, 300).value();
+    return std::format("{},{},{}", best.top_left.x() + 1,
+                       best.top_left.y() + 1, best.size);
   }
 };
 
@@ -1,5 +1,8 @@
 #include <aoc_lib/algorithm.hpp>
+#include <aoc_lib/cycle.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/geometry/stencil.hpp>
+#include <aoc_lib/hash.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
@@ -40,6 +43,27 @@ template <plants R> int64_t score_plants(R &&range) {
       }));
 }
 
+using automaton_t = aoc::stencil<uint8_t>;
+
+// Hash of the pots from the first plant to the last one, wherever they are
+size_t pattern_of(const automaton_t &automaton) {
+  const auto pots = automaton.grid().row(0);
+  const auto first = std::ranges::find(pots, uint8_t{1});
+  aoc::hash_accumulator hash;
+  if (first == pots.end()) {
+    return hash.result();
+  }
+  const auto last =
+      std::ranges::find(pots | std::views::reverse, uint8_t{1}).base();
+  if (first == pots.begin() || last == pots.end()) {
+    throw std::runtime_error("Plants reached the edge of the simulated pots");
+  }
+  for (uint8_t pot : std::ranges::subrange(first, last)) {
+    hash.accumulate(pot);
+  }
+  return hash.result();
+}
+
 struct d12 {
   static data convert(std::string_view input) {
     auto lines = aoc::lines(aoc::trimmed(input));
@@ -75,41 +99,38 @@ struct d12 {
   }
 
   static std::pair<int64_t, int64_t> run(const data &d) {
-    auto cur =
-        std::vector(d.initial_state.size() + 4 * MAX_GENERATION_COUNT, false);
-    std::ranges::copy(d.initial_state, cur.begin() + 2 * MAX_GENERATION_COUNT);
-    auto cur_score = score_plants(cur);
-    auto next = cur;
-    size_t cur_generation = 0;
-    int64_t part1;
-    int64_t last_delta = 0;
-    std::optional<int64_t> stable_delta;
-
-    while (cur_generation < MAX_GENERATION_COUNT &&
-           (cur_generation < 20 || !stable_delta)) {
-      ++cur_generation;
-      std::ranges::transform(
-          cur | std::views::slide(5), next.begin() + 2, [&d](auto &&subrange) {
-            return d.growth_patterns.contains(make_plant_matcher(subrange));
-          });
-      std::swap(cur, next);
-      auto score = score_plants(cur);
-      if (cur_generation == 20) {
-        part1 = score;
-      }
-      auto delta = score - cur_score;
-      if (delta == last_delta) {
-        stable_delta = delta;
-      }
-      last_delta = delta;
-      cur_score = score;
-    }
-    if (!stable_delta) {
-      throw std::runtime_error("Could not find a stable delta");
-    }
-
-    return std::make_pair(part1, cur_score + (50000000000 - cur_generation) *
-                                                 *stable_delta);
+    const auto GENERATIONS = 50000000000uz;
+
+    auto pots = aoc::dyn_matrix<uint8_t>(
+        d.initial_state.size() + 4 * MAX_GENERATION_COUNT, 1);
+    std::ranges::copy(d.initial_state,
+                      pots.row(0).begin() + 2 * MAX_GENERATION_COUNT);
+    const auto initial = automaton_t(aoc::padded_matrix(pots, 2, uint8_t{}));
+    const auto window = std::to_array<ptrdiff_t>({-2, -1, 0, 1, 2});
+    const auto step = [&d, &window](automaton_t &automaton) {
+      automaton.step(window, [&d](uint8_t, const auto &neighbours) {
+        uint8_t pattern = 0;
+        for (size_t k = 0; k < neighbours.size(); ++k) {
+          pattern = static_cast<uint8_t>(pattern << 1 | neighbours[k]);
+        }
+        return static_cast<uint8_t>(d.growth_patterns.contains(pattern));
+      });
+    };
+    auto score_after = [&](size_t generations) {
+      return score_plants(
+          aoc::advance(initial, step, generations).grid().row(0));
+    };
+
+    // The plants end up moving as a whole, so that the score then grows by
+    // the same amount every cycle.
+    const auto cycle = aoc::find_cycle(initial, step, pattern_of);
+    const size_t equivalent = cycle.index_of(GENERATIONS);
+    const auto score = score_after(equivalent);
+    const auto delta = score_after(equivalent + cycle.length) - score;
+    const auto cycles = (GENERATIONS - equivalent) / cycle.length;
+
+    return std::make_pair(score_after(20),
+                          score + static_cast<int64_t>(cycles) * delta);
   }
 };
 
@@ -146,4 +167,6 @@ const auto test_data =
 
 TEST(d12, part1) { EXPECT_EQ(aoc::part1<d12>(test_data), 325); }
 
+TEST(d12, part2) { EXPECT_EQ(aoc::part2<d12>(test_data), 999999999374); }
+
 #endif
\ No newline at end of file
@@ -1,17 +1,19 @@
 #include <aoc_lib/day_trait.hpp>
 #include <aoc_lib/geometry/algorithm.hpp>
 #include <aoc_lib/geometry/dyn_matrix.hpp>
+#include <aoc_lib/geometry/grid_search.hpp>
 #include <aoc_lib/geometry/point.hpp>
 #include <aoc_lib/geometry/vector.hpp>
 #include <aoc_lib/overload.hpp>
+#include <aoc_lib/parallel.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <cassert>
 #include <format>
 #include <limits>
 #include <set>
-#include <unordered_map>
 #include <variant>
+#include <vector>
 
 using id_t = uint8_t;
 
@@ -90,34 +92,25 @@ struct reading_order_cmp {
 
 using set = std::set<point2d, reading_order_cmp>;
 
+using search_t = aoc::grid_search<>;
+
 // Returns the next position for the current unit
-static point2d find_move(point2d start, const game_map &map,
-                         cell_matcher target_matcher) {
-  auto to_visit = set{start};
-  auto previous = std::unordered_map<point2d, point2d>{};
-  while (!to_visit.empty()) {
-    auto next_visit = set{};
-    for (point2d cur : to_visit) {
-      for (vector2d dir : read_directions) {
-        point2d next = cur + dir;
-        if (next.x() >= 0 && next.y() >= 0 && map.contains(next)) {
-          if (target_matcher(map[next])) {
-            auto prev = cur;
-            while (cur != start) {
-              prev = cur;
-              cur = previous.at(cur);
-            }
-            return prev;
-          }
-          if (is_empty(map[next]) && previous.emplace(next, cur).second) {
-            next_visit.insert(next);
-          }
-        }
-      }
-    }
-    to_visit = std::move(next_visit);
+static point2d find_move(point2d from, const game_map &map,
+                         cell_matcher target_matcher, search_t &search) {
+  const search_t::point_t start = from;
+  auto target = search.bfs(
+      start, [&map](const search_t::point_t &p) { return is_empty(map[p]); },
+      [&](const search_t::point_t &p) { return target_matcher(map[p]); },
+      aoc::neighbour_orders::reading);
+  if (!target) {
+    return from;
   }
-  return start;
+  // Step next to the unit on the way to the cell the target was seen from
+  auto move = search.parent(*target);
+  while (move != start && search.parent(move) != start) {
+    move = search.parent(move);
+  }
+  return move;
 }
 
 enum race_t { goblins, elves };
@@ -134,6 +127,7 @@ struct simulation_result {
 };
 
 simulation_result run_simulation(state_t state, hp_t elf_damage) {
+  auto search = search_t(state.map.width(), state.map.height());
   size_t round = 0;
   while (true) {
     set turn_order;
@@ -164,7 +158,7 @@ simulation_result run_simulation(state_t state, hp_t elf_damage) {
                      state.map[cur]);
       // Move
       {
-        auto move = find_move(cur, state.map, enemy_matcher);
+        auto move = find_move(cur, state.map, enemy_matcher, search);
         if (move != cur) {
           std::swap(state.map[cur], state.map[move]);
           cur = move;
@@ -278,14 +272,28 @@ struct d15 {
     }
     hp_t lower_bound = 3, upper_bound = 200;
     while (upper_bound - lower_bound > 1) {
-      hp_t next = (upper_bound + lower_bound) / 2;
-      auto result = run_simulation(state, next);
-      if (result.winners == race_t::elves &&
-          std::ranges::all_of(result.winner_states, is_alive)) {
-        lowest_result = result;
-        upper_bound = next;
-      } else {
-        lower_bound = next;
+      // One damage level per thread, evenly spread between the bounds: with a
+      // single thread, this is a bisection
+      const size_t levels = std::min<size_t>(aoc::concurrency(),
+                                             upper_bound - lower_bound - 1);
+      auto damages = std::vector<hp_t>(levels);
+      for (size_t i = 0; i < levels; ++i) {
+        damages[i] = static_cast<hp_t>(
+            lower_bound + (upper_bound - lower_bound) * (i + 1) / (levels + 1));
+      }
+      auto results = std::vector<simulation_result>(levels);
+      aoc::parallel_for(levels, [&](size_t i) {
+        results[i] = run_simulation(state, damages[i]);
+      });
+
+      for (size_t i = 0; i < levels; ++i) {
+        if (results[i].winners == race_t::elves &&
+            std::ranges::all_of(results[i].winner_states, is_alive)) {
+          lowest_result = std::move(results[i]);
+          upper_bound = damages[i];
+          break;
+        }
+        lower_bound = damages[i];
       }
     }
     return lowest_result.score();
@@ -384,6 +392,16 @@ TEST_P(d15, example) {
   }
 }
 
+TEST_P(d15, example_threads) {
+  test_data_t test = GetParam();
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  EXPECT_EQ(aoc::part1<::d15>(test.args), test.part1);
+  if (test.part2) {
+    EXPECT_EQ(aoc::part2<::d15>(test.args), test.part2);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(d15, d15, testing::ValuesIn(test_data),
                          [](const testing::TestParamInfo<test_data_t> &info) {
                            return testing::PrintToString(info.param.part1);
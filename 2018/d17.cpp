@@ -1,5 +1,6 @@
 #include <aoc_lib/day_trait.hpp>
 #include <aoc_lib/geometry/dyn_matrix.hpp>
+#include <aoc_lib/geometry/sparse_grid.hpp>
 #include <aoc_lib/geometry/vector.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
@@ -13,24 +14,7 @@ using vector = aoc::vector2d<int64_t>;
 
 enum unit_t { sand, clay, still_water, running_water };
 
-class units_t {
-public:
-  void set(point p, unit_t u) { m_map.insert_or_assign(p, u); }
-
-  unit_t get(point p) const {
-    auto found = m_map.find(p);
-    if (found == m_map.end()) {
-      return unit_t::sand;
-    }
-    return found->second;
-  }
-
-  auto begin() const { return m_map.begin(); }
-  auto end() const { return m_map.end(); }
-
-private:
-  std::unordered_map<point, unit_t> m_map;
-};
+using units_t = aoc::sparse_grid<unit_t>;
 
 struct data_t {
   units_t map;
@@ -233,10 +217,9 @@ struct d17 {
   static std::pair<size_t, size_t> run(const data_t &d) {
     auto sim = water_simulation(d);
     sim.visit_source(point{500, d.upper_bound - 1});
-    auto running = std::ranges::count(sim.map() | std::views::values,
-                                      unit_t::running_water);
-    auto still =
-        std::ranges::count(sim.map() | std::views::values, unit_t::still_water);
+    auto running =
+        std::ranges::count(sim.map().values(), unit_t::running_water);
+    auto still = std::ranges::count(sim.map().values(), unit_t::still_water);
     return std::make_pair(running + still, still);
   }
 };
@@ -1,120 +1,68 @@
+#include <aoc_lib/cycle.hpp>
 #include <aoc_lib/day_trait.hpp>
 #include <aoc_lib/geometry/dyn_matrix.hpp>
+#include <aoc_lib/geometry/grid_input.hpp>
+#include <aoc_lib/geometry/stencil.hpp>
+#include <aoc_lib/hash.hpp>
 #include <aoc_lib/string.hpp>
 
-#include <cassert>
+using area_t = aoc::padded_matrix<uint8_t>;
+using automaton_t = aoc::stencil<uint8_t>;
 
-using area_t = aoc::dyn_matrix<char>;
-using point = aoc::point2d<size_t>;
-
-struct stats_t {
-  size_t tree = 0;
-  size_t lumber = 0;
-
-  void inspect(char c) {
-    if (c == '|') {
-      ++tree;
-    } else if (c == '#') {
-      ++lumber;
-    }
-  }
-};
+constexpr auto ALPHABET = aoc::grid_alphabet(".|#");
+constexpr auto OPEN = ALPHABET.code('.');
+constexpr auto TREES = ALPHABET.code('|');
+constexpr auto LUMBERYARD = ALPHABET.code('#');
 
 size_t score_of(const area_t &area) {
-  stats_t stats;
-  for (char c : area.data_view()) {
-    stats.inspect(c);
+  size_t trees = 0;
+  size_t lumberyards = 0;
+  for (size_t i : area.indices()) {
+    trees += area[i] == TREES;
+    lumberyards += area[i] == LUMBERYARD;
   }
-  return stats.tree * stats.lumber;
+  return trees * lumberyards;
 }
 
-void iterate_area_to(const area_t &from, area_t &to) {
-  assert(from.width() == to.width());
-  assert(from.height() == to.height());
-
-  for (auto [p, c] : from.enumerate()) {
-    to[p] = [&from](point p, char c) {
-      stats_t stats;
-      if (p.x() > 0) {
-        if (p.y() > 0) {
-          stats.inspect(from[{p.x() - 1, p.y() - 1}]);
-        }
-        stats.inspect(from[{p.x() - 1, p.y()}]);
-        if (p.y() + 1 < from.height()) {
-          stats.inspect(from[{p.x() - 1, p.y() + 1}]);
-        }
-      }
-      if (p.y() > 0) {
-        stats.inspect(from[{p.x(), p.y() - 1}]);
-      }
-      if (p.y() + 1 < from.height()) {
-        stats.inspect(from[{p.x(), p.y() + 1}]);
-      }
-      if (p.x() + 1 < from.width()) {
-        if (p.y() > 0) {
-          stats.inspect(from[{p.x() + 1, p.y() - 1}]);
-        }
-        stats.inspect(from[{p.x() + 1, p.y()}]);
-        if (p.y() + 1 < from.height()) {
-          stats.inspect(from[{p.x() + 1, p.y() + 1}]);
-        }
-      }
-
-      switch (c) {
-      case '.':
-        return stats.tree >= 3 ? '|' : '.';
-      case '|':
-        return stats.lumber >= 3 ? '#' : '|';
-      case '#':
-        return stats.tree >= 1 && stats.lumber >= 1 ? '#' : '.';
-      }
-      std::unreachable();
-    }(p, c);
+size_t fingerprint(const automaton_t &automaton) {
+  aoc::hash_accumulator hash;
+  for (uint8_t c : automaton.grid().data()) {
+    hash.accumulate(c);
   }
+  return hash.result();
 }
 
+constexpr auto next_acre = [](uint8_t c, const auto &neighbours) -> uint8_t {
+  if (c == OPEN) {
+    return neighbours.count(TREES) >= 3 ? TREES : OPEN;
+  }
+  if (c == TREES) {
+    return neighbours.count(LUMBERYARD) >= 3 ? LUMBERYARD : TREES;
+  }
+  return neighbours.count(TREES) >= 1 && neighbours.count(LUMBERYARD) >= 1
+             ? LUMBERYARD
+             : OPEN;
+};
+
 struct d18 {
-  static area_t convert(std::string_view input) {
-    size_t width = 0;
-    size_t height = 0;
-    std::vector<char> data;
-    data.reserve(input.size());
-    for (std::string_view line : aoc::lines(aoc::trimmed(input))) {
-      if (width == 0) {
-        width = line.size();
-      }
-      assert(width == line.size());
-      ++height;
-      data.append_range(line);
-    }
-    return area_t{width, height, std::move(data)};
+  static aoc::dyn_matrix<uint8_t> convert(std::string_view input) {
+    return aoc::char_grid(input, ALPHABET);
   }
 
-  static std::pair<size_t, size_t> run(area_t area) {
+  static std::pair<size_t, size_t> run(const aoc::dyn_matrix<uint8_t> &area) {
     const auto PART1 = 10uz;
     const auto PART2 = 1000000000uz;
 
-    std::vector<area_t> history;
-    area_t next = area;
-    size_t cycle_start;
-    size_t cycle_end;
-
-    while (true) {
-      auto found = std::ranges::find(history, area);
-      if (found != history.end()) {
-        cycle_start = found - history.begin();
-        cycle_end = history.size();
-        break;
-      }
-      history.push_back(area);
-      iterate_area_to(area, next);
-      std::swap(area, next);
-    }
+    // The border is open ground, which no rule counts
+    const auto initial = automaton_t(area_t(area, 1, OPEN));
+    const auto step = [](automaton_t &automaton) {
+      automaton.step(aoc::adjacent_type::euclidean, next_acre);
+    };
+    const auto cycle = aoc::find_cycle(initial, step, fingerprint);
 
     return std::make_pair(
-        score_of(history[PART1]),
-        score_of(history[(PART2 - cycle_start) % (cycle_end - cycle_start) +
-                         cycle_start]));
+        score_of(aoc::advance(initial, step, PART1).grid()),
+        score_of(aoc::advance(initial, step, cycle.index_of(PART2)).grid()));
   }
 };
 
@@ -1,8 +1,10 @@
 #include <aoc_lib/day_trait.hpp>
 #include <aoc_lib/geometry/point.hpp>
 #include <aoc_lib/geometry/vector.hpp>
+#include <aoc_lib/small_vector.hpp>
 #include <aoc_lib/string.hpp>
 
+#include <algorithm>
 #include <print>
 #include <stack>
 #include <unordered_map>
@@ -11,7 +13,9 @@
 using point_t = aoc::point2d<int64_t>;
 using points_t = std::unordered_set<point_t>;
 using vec_t = aoc::vector2d<int64_t>;
-using graph_t = std::unordered_map<point_t, std::unordered_set<point_t>>;
+// Each room has at most four doors
+using doors_t = aoc::small_vector<point_t, 4>;
+using graph_t = std::unordered_map<point_t, doors_t>;
 
 void print_graph(const graph_t &g) {
   int64_t x_min, x_max, y_min, y_max;
@@ -36,24 +40,18 @@ void print_graph(const graph_t &g) {
                                g.contains({x - 1, y - 1})
                            ? '#'
                            : ' ');
-      std::print("{}",
-                 !exists && !above_exists
-                     ? ' '
-                     : (exists && above_exists && g.at(above).contains({x, y})
-                            ? '-'
-                            : '#'));
+      bool door = exists && above_exists &&
+                  std::ranges::contains(g.at(above), point_t{x, y});
+      std::print("{}", !exists && !above_exists ? ' ' : (door ? '-' : '#'));
     }
     std::println();
     if (y <= y_max) {
       for (int64_t x = x_min; x <= x_max + 1; ++x) {
         bool exists = g.contains({x, y});
         bool left_exists = g.contains({x - 1, y});
-        std::print("{}", !exists && !left_exists
-                             ? ' '
-                             : (exists && left_exists &&
-                                        g.at({x, y}).contains({x - 1, y})
-                                    ? '|'
-                                    : '#'));
+        bool door = exists && left_exists &&
+                    std::ranges::contains(g.at({x, y}), point_t{x - 1, y});
+        std::print("{}", !exists && !left_exists ? ' ' : (door ? '|' : '#'));
         std::print("{}", x == 0 && y == 0 ? 'X' : (exists ? '.' : ' '));
       }
       std::println();
@@ -61,14 +59,20 @@ void print_graph(const graph_t &g) {
   }
 }
 
+void add_door(point_t from, point_t to, graph_t &graph) {
+  if (auto &doors = graph[from]; !std::ranges::contains(doors, to)) {
+    doors.push_back(to);
+  }
+}
+
 points_t move_all_points(const points_t &points, vec_t vec, graph_t &graph) {
   points_t result;
   result.reserve(points.size());
   for (point_t from : points) {
     point_t to = from + vec;
     result.insert(to);
-    graph[from].insert(to);
-    graph[to].insert(from);
+    add_door(from, to, graph);
+    add_door(to, from, graph);
   }
   return result;
 }
@@ -1,5 +1,6 @@
 #include "device.hpp"
 
+#include <aoc_lib/cycle.hpp>
 #include <aoc_lib/day_trait.hpp>
 #include <aoc_lib/overload.hpp>
 
@@ -7,7 +8,6 @@
 #include <iterator>
 #include <print>
 #include <ranges>
-#include <unordered_set>
 #include <variant>
 
 using device::program_t;
@@ -388,14 +388,10 @@ struct d21 {
     // condition
     // dump_help(p);
 
-    auto solutions = std::unordered_set<value_t>();
-    auto first = std::optional<value_t>();
-    auto last = std::optional<value_t>();
-    value_t r3 = 0, r4 = 0;
-    // The program can be simplified to the following, most likely you'd have to
-    // change the magic numbers
-    while (true) {
-      r3 = r4 | 65536;
+    // The program can be simplified to the following step on r4, most likely
+    // you'd have to change the magic numbers. It halts when r0 matches r4.
+    const auto step = [](value_t &r4) {
+      value_t r3 = r4 | 65536;
       r4 = 4332021;
       while (true) {
         r4 = (((r4 + (r3 & 255)) & 16777215) * 65899) & 16777215;
@@ -403,13 +399,11 @@ struct d21 {
           break;
         r3 = (r3 / 256);
       }
-      if (!solutions.insert(r4).second)
-        break;
-      if (!first)
-        first = r4;
-      last = r4;
-    }
-    return {*first, *last};
+    };
+    // The longest run is for the last value of r4 before they repeat
+    const value_t first = aoc::advance(value_t{}, step, 1);
+    const auto cycle = aoc::find_cycle(first, step);
+    return {first, aoc::advance(first, step, cycle.start + cycle.length - 1)};
   }
 };
 
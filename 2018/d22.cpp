@@ -1,13 +1,13 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/dijkstra.hpp>
 #include <aoc_lib/geometry/point.hpp>
+#include <aoc_lib/geometry/sparse_grid.hpp>
 #include <aoc_lib/geometry/vector.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
-#include <generator>
+#include <limits>
 #include <print>
-#include <unordered_map>
-#include <unordered_set>
 
 using point2d = aoc::point2d<size_t>;
 
@@ -22,14 +22,15 @@ public:
   point2d target() const { return m_target; }
 
 private:
+  static constexpr size_t unknown = std::numeric_limits<size_t>::max();
+
   size_t erosion_level(point2d coordinate) {
-    auto found = m_erosion_levels.find(coordinate);
-    if (found != m_erosion_levels.end()) {
-      return found->second;
+    if (size_t level = m_erosion_levels.get(coordinate); level != unknown) {
+      return level;
     }
-    return m_erosion_levels
-        .emplace(coordinate, (geologic_index(coordinate) + m_depth) % 20183)
-        .first->second;
+    const size_t level = (geologic_index(coordinate) + m_depth) % 20183;
+    m_erosion_levels.set(coordinate, level);
+    return level;
   }
 
   size_t geologic_index(point2d coordinate) {
@@ -45,7 +46,7 @@ private:
 
   size_t m_depth;
   point2d m_target;
-  std::unordered_map<point2d, size_t> m_erosion_levels;
+  aoc::sparse_grid<size_t> m_erosion_levels{unknown};
 };
 
 enum class tool_t { torch, climbing_gear, neither };
@@ -96,72 +97,37 @@ struct d22 {
 
     const auto start = state{{0, 0}, tool_t::torch};
     const auto target = state{cave.target(), tool_t::torch};
-    auto visited = std::unordered_set<state>();
-    auto to_visit = std::unordered_map<state, size_t>({{start, 0}});
-    using timed_state = decltype(to_visit)::value_type;
-
-    auto generate_neighbors =
-        [&cave](const timed_state &ts) -> std::generator<timed_state> {
-      auto [cur, time] = ts;
-      // left
-      if (cur.coordinate.x() > 0) {
-        point2d next = {cur.coordinate.x() - 1, cur.coordinate.y()};
-        if (is_region_compatible(cave.region_type(next), cur.tool)) {
-          co_yield {{next, cur.tool}, time + 1};
-        }
-      }
-      // up
-      if (cur.coordinate.y() > 0) {
-        point2d next = {cur.coordinate.x(), cur.coordinate.y() - 1};
-        if (is_region_compatible(cave.region_type(next), cur.tool)) {
-          co_yield {{next, cur.tool}, time + 1};
-        }
-      }
-      // right
-      {
-        point2d next = {cur.coordinate.x() + 1, cur.coordinate.y()};
+
+    auto neighbours = [&cave](const state &cur, auto &&visit) {
+      const point2d p = cur.coordinate;
+      auto move = [&](point2d next) {
         if (is_region_compatible(cave.region_type(next), cur.tool)) {
-          co_yield {{next, cur.tool}, time + 1};
+          visit(state{next, cur.tool}, 1);
         }
+      };
+      if (p.x() > 0) {
+        move({p.x() - 1, p.y()});
       }
-      // down
-      {
-        point2d next = {cur.coordinate.x(), cur.coordinate.y() + 1};
-        if (is_region_compatible(cave.region_type(next), cur.tool)) {
-          co_yield {{next, cur.tool}, time + 1};
-        }
+      if (p.y() > 0) {
+        move({p.x(), p.y() - 1});
       }
+      move({p.x() + 1, p.y()});
+      move({p.x(), p.y() + 1});
       // swapping tool
       for (tool_t next :
            {tool_t::torch, tool_t::climbing_gear, tool_t::neither}) {
         if (next != cur.tool &&
-            is_region_compatible(cave.region_type(cur.coordinate), next)) {
-          co_yield {{cur.coordinate, next}, time + 7};
+            is_region_compatible(cave.region_type(p), next)) {
+          visit(state{p, next}, 7);
         }
       }
     };
 
-    while (!to_visit.empty()) {
-      auto closest =
-          std::ranges::min_element(to_visit, {}, &timed_state::second);
-      auto cur = *closest;
-      if (cur.first == target) {
-        return {risk, cur.second};
-      }
-      to_visit.erase(closest);
-      visited.insert(cur.first);
-      for (auto [next, next_time] : generate_neighbors(cur)) {
-        if (!visited.contains(next)) {
-          auto [it, was_inserted] = to_visit.insert({next, next_time});
-          if (!was_inserted) {
-            it->second = std::min(it->second, next_time);
-          }
-        }
-      }
+    auto is_target = [&target](const state &s) { return s == target; };
+    if (auto time = aoc::dijkstra(start, 7, neighbours, is_target)) {
+      return {risk, *time};
     }
     throw std::runtime_error("Couldn't reach target");
-
-    // return {risk, 0};
   }
 };
 
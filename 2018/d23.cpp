@@ -1,12 +1,21 @@
+#include <aoc_lib/best_first_search.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/geometry/box.hpp>
+#include <aoc_lib/geometry/manhattan_ball_index.hpp>
 #include <aoc_lib/geometry/point.hpp>
 #include <aoc_lib/geometry/vector.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
-#include <generator>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
 #include <ranges>
-#include <set>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 
 using value_t = int64_t;
 using point_t = aoc::point3d<value_t>;
@@ -14,10 +23,7 @@ using vector_t = aoc::vector3d<value_t>;
 
 constexpr auto ORIGIN = point_t{0, 0, 0};
 
-struct sphere_t {
-  point_t pos;
-  value_t r;
-};
+using sphere_t = aoc::manhattan_ball<value_t, 3>;
 
 // Cube is aligned on the axis
 struct oriented_cube_t {
@@ -25,84 +31,65 @@ struct oriented_cube_t {
   value_t half_size;
 };
 
-bool intersects(const sphere_t &sphere, const oriented_cube_t &cube) {
-  auto c1 =
-      cube.center + vector_t{-cube.half_size, -cube.half_size, -cube.half_size};
-  auto c2 =
-      cube.center + vector_t{cube.half_size, cube.half_size, cube.half_size};
-  auto dist = sphere.r;
-  if (sphere.pos.x() < c1.x())
-    dist -= c1.x() - sphere.pos.x();
-  else if (sphere.pos.x() > c2.x())
-    dist -= sphere.pos.x() - c2.x();
-  if (sphere.pos.y() < c1.y())
-    dist -= c1.y() - sphere.pos.y();
-  else if (sphere.pos.y() > c2.y())
-    dist -= sphere.pos.y() - c2.y();
-  if (sphere.pos.z() < c1.z())
-    dist -= c1.z() - sphere.pos.z();
-  else if (sphere.pos.z() > c2.z())
-    dist -= sphere.pos.z() - c2.z();
-  return dist >= 0;
+aoc::box<value_t, 3> bounds(const oriented_cube_t &cube) {
+  const auto half = vector_t{cube.half_size, cube.half_size, cube.half_size};
+  return {cube.center - half, cube.center + half};
+}
+
+// Distance from the origin to the closest point of the cube
+value_t distance_to_origin(const oriented_cube_t &cube) {
+  value_t res = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    res += std::max(std::abs(cube.center[i]) - cube.half_size, value_t{0});
+  }
+  return res;
 }
 
+// Ranked by bounds on the points of the cube, so that no point ranks before
+// the cube holding it
 struct search_space_t {
-  size_t missing_bots;
-  value_t distance; // cached distance to origin
+  size_t missing_bots; // bots out of reach of the whole cube
+  value_t distance;    // cached distance from the origin to the cube
   oriented_cube_t cube;
 
-  auto cmp_tuple() const {
-    return std::make_tuple(missing_bots, distance, cube.center.x(),
-                           cube.center.y(), cube.center.z());
-  }
+  auto cmp_tuple() const { return std::make_tuple(missing_bots, distance); }
 
   friend bool operator<(const search_space_t &l, const search_space_t &r) {
     return l.cmp_tuple() < r.cmp_tuple();
   }
 };
 
-std::generator<oriented_cube_t> split_search(const oriented_cube_t &cube) {
+// Enough room for the children of a unit cube
+constexpr size_t MAX_SPLITS = 27;
+
+// Writes the children of the cube to out, which holds at least MAX_SPLITS
+// cubes, and returns how many there are. Children go to storage owned by the
+// caller, so that expanding a node costs no allocation nor coroutine frame.
+size_t split_search(const oriented_cube_t &cube,
+                    std::span<oriented_cube_t> out) {
+  assert(out.size() >= MAX_SPLITS);
   const auto &[center, old_radius] = cube;
+  size_t count = 0;
   if (old_radius == 1) {
     // if radius is one, inspect every single points
-    co_yield {center + vector_t{0, 0, -1}, 0};
-    co_yield {center + vector_t{0, 0, 0}, 0};
-    co_yield {center + vector_t{0, 0, 1}, 0};
-    co_yield {center + vector_t{0, -1, -1}, 0};
-    co_yield {center + vector_t{0, -1, 0}, 0};
-    co_yield {center + vector_t{0, -1, 1}, 0};
-    co_yield {center + vector_t{0, 1, -1}, 0};
-    co_yield {center + vector_t{0, 1, 0}, 0};
-    co_yield {center + vector_t{0, 1, 1}, 0};
-    co_yield {center + vector_t{-1, 0, -1}, 0};
-    co_yield {center + vector_t{-1, 0, 0}, 0};
-    co_yield {center + vector_t{-1, 0, 1}, 0};
-    co_yield {center + vector_t{-1, -1, -1}, 0};
-    co_yield {center + vector_t{-1, -1, 0}, 0};
-    co_yield {center + vector_t{-1, -1, 1}, 0};
-    co_yield {center + vector_t{-1, 1, -1}, 0};
-    co_yield {center + vector_t{-1, 1, 0}, 0};
-    co_yield {center + vector_t{-1, 1, 1}, 0};
-    co_yield {center + vector_t{1, 0, -1}, 0};
-    co_yield {center + vector_t{1, 0, 0}, 0};
-    co_yield {center + vector_t{1, 0, 1}, 0};
-    co_yield {center + vector_t{1, -1, -1}, 0};
-    co_yield {center + vector_t{1, -1, 0}, 0};
-    co_yield {center + vector_t{1, -1, 1}, 0};
-    co_yield {center + vector_t{1, 1, -1}, 0};
-    co_yield {center + vector_t{1, 1, 0}, 0};
-    co_yield {center + vector_t{1, 1, 1}, 0};
+    for (value_t x : {-1, 0, 1}) {
+      for (value_t y : {-1, 0, 1}) {
+        for (value_t z : {-1, 0, 1}) {
+          out[count++] = {center + vector_t{x, y, z}, 0};
+        }
+      }
+    }
   } else {
     const auto radius = old_radius / 2;
-    co_yield {center + vector_t{radius, radius, radius}, radius};
-    co_yield {center + vector_t{radius, radius, -radius}, radius};
-    co_yield {center + vector_t{radius, -radius, radius}, radius};
-    co_yield {center + vector_t{radius, -radius, -radius}, radius};
-    co_yield {center + vector_t{-radius, radius, radius}, radius};
-    co_yield {center + vector_t{-radius, radius, -radius}, radius};
-    co_yield {center + vector_t{-radius, -radius, radius}, radius};
-    co_yield {center + vector_t{-radius, -radius, -radius}, radius};
+    for (value_t x : {radius, -radius}) {
+      for (value_t y : {radius, -radius}) {
+        for (value_t z : {radius, -radius}) {
+          out[count++] = {center + vector_t{x, y, z}, radius};
+        }
+      }
+    }
   }
+  return count;
 }
 
 using data_t = std::vector<sphere_t>;
@@ -116,51 +103,52 @@ struct d23 {
               static const auto re =
                   std::regex(R"(pos=<(-?\d+),(-?\d+),(-?\d+)>, r=(\d+))");
               auto match = *aoc::regex_match(line, re);
-              return sphere_t{.pos = {*aoc::from_chars<value_t>(match.str(1)),
-                                      *aoc::from_chars<value_t>(match.str(2)),
-                                      *aoc::from_chars<value_t>(match.str(3))},
-                              .r = *aoc::from_chars<value_t>(match.str(4))};
+              return sphere_t{
+                  .center = {*aoc::from_chars<value_t>(match.str(1)),
+                             *aoc::from_chars<value_t>(match.str(2)),
+                             *aoc::from_chars<value_t>(match.str(3))},
+                  .radius = *aoc::from_chars<value_t>(match.str(4))};
             }));
   }
 
   static size_t part1(const data_t &bots) {
-    sphere_t strongest = std::ranges::max(bots, {}, &sphere_t::r);
+    sphere_t strongest = std::ranges::max(bots, {}, &sphere_t::radius);
     return std::ranges::count_if(bots, [&strongest](const sphere_t &n) {
-      return aoc::manhattan_distance(strongest.pos, n.pos) <= strongest.r;
+      return aoc::manhattan_distance(strongest.center, n.center) <=
+             strongest.radius;
     });
   }
 
   static size_t part2(const data_t &bots) {
     value_t max_dist =
         std::ranges::max(bots | std::views::transform([](const auto &b) {
-                           return aoc::manhattan_distance(b.pos, ORIGIN);
+                           return aoc::manhattan_distance(b.center, ORIGIN);
                          }));
+    const auto index = aoc::manhattan_ball_index(std::from_range, bots);
     value_t starting_radius = 1;
     while (starting_radius < max_dist) {
       starting_radius *= 2;
     }
-    auto to_search = std::set({search_space_t{
-        .missing_bots = 0,
-        .distance = 0,
-        .cube = {.center = ORIGIN, .half_size = starting_radius}}});
-
-    while (!to_search.empty()) {
-      auto cur = *to_search.begin();
-      to_search.erase(to_search.begin());
-      if (cur.cube.half_size == 0) {
-        return cur.distance;
-      }
-      for (oriented_cube_t splitted : split_search(cur.cube)) {
-        auto new_space = search_space_t{
-            .missing_bots = static_cast<size_t>(
-                std::ranges::count_if(bots,
-                                      [&splitted](const sphere_t &bot) {
-                                        return !intersects(bot, splitted);
-                                      })),
-            .distance = aoc::manhattan_distance(splitted.center, ORIGIN),
-            .cube = splitted};
-        to_search.insert(new_space);
-      }
+    auto make_space = [&](const oriented_cube_t &cube) {
+      return search_space_t{
+          .missing_bots = bots.size() - index.count_intersecting(bounds(cube)),
+          .distance = distance_to_origin(cube),
+          .cube = cube};
+    };
+
+    auto best = aoc::best_first_search(
+        make_space({.center = ORIGIN, .half_size = starting_radius}),
+        [&](const search_space_t &cur, auto &&push) {
+          auto splits = std::array<oriented_cube_t, MAX_SPLITS>();
+          const size_t count = split_search(cur.cube, splits);
+          for (const oriented_cube_t &splitted :
+               std::span(splits).first(count)) {
+            push(make_space(splitted));
+          }
+        },
+        [](const search_space_t &cur) { return cur.cube.half_size == 0; });
+    if (best) {
+      return static_cast<size_t>(best->distance);
     }
     throw std::runtime_error("No solution found");
   }
@@ -191,16 +179,152 @@ pos=<1,3,1>, r=1
             7);
 }
 
-TEST(d23, part2) {
-  EXPECT_EQ(aoc::part2<d23>(aoc::arguments::make_example(R"(
+const auto PART2_EXAMPLE = aoc::arguments::make_example(R"(
 pos=<10,12,12>, r=2
 pos=<12,14,12>, r=2
 pos=<16,12,12>, r=4
 pos=<14,14,14>, r=6
 pos=<50,50,50>, r=200
 pos=<10,10,10>, r=5
+)");
+
+TEST(d23, part2) { EXPECT_EQ(aoc::part2<d23>(PART2_EXAMPLE), 36); }
+
+// Ranking cubes by the distance to their center used to stop on the bot at
+// distance 17
+TEST(d23, part2_closest_bot) {
+  EXPECT_EQ(aoc::part2<d23>(aoc::arguments::make_example(R"(
+pos=<4,-20,-2>, r=1
+pos=<2,8,4>, r=0
+pos=<-5,12,3>, r=3
 )")),
-            36);
+            14);
 }
 
+TEST(d23, part2_threads) {
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  EXPECT_EQ(aoc::part2<d23>(PART2_EXAMPLE), 36);
+}
+
+#if defined(__cpp_lib_generator)
+
+#include <algorithm>
+#include <chrono>
+#include <generator>
+#include <vector>
+
+// Former coroutine version of split_search
+std::generator<oriented_cube_t>
+split_search_generator(const oriented_cube_t &cube) {
+  const auto &[center, old_radius] = cube;
+  if (old_radius == 1) {
+    // if radius is one, inspect every single points
+    co_yield {center + vector_t{0, 0, -1}, 0};
+    co_yield {center + vector_t{0, 0, 0}, 0};
+    co_yield {center + vector_t{0, 0, 1}, 0};
+    co_yield {center + vector_t{0, -1, -1}, 0};
+    co_yield {center + vector_t{0, -1, 0}, 0};
+    co_yield {center + vector_t{0, -1, 1}, 0};
+    co_yield {center + vector_t{0, 1, -1}, 0};
+    co_yield {center + vector_t{0, 1, 0}, 0};
+    co_yield {center + vector_t{0, 1, 1}, 0};
+    co_yield {center + vector_t{-1, 0, -1}, 0};
+    co_yield {center + vector_t{-1, 0, 0}, 0};
+    co_yield {center + vector_t{-1, 0, 1}, 0};
+    co_yield {center + vector_t{-1, -1, -1}, 0};
+    co_yield {center + vector_t{-1, -1, 0}, 0};
+    co_yield {center + vector_t{-1, -1, 1}, 0};
+    co_yield {center + vector_t{-1, 1, -1}, 0};
+    co_yield {center + vector_t{-1, 1, 0}, 0};
+    co_yield {center + vector_t{-1, 1, 1}, 0};
+    co_yield {center + vector_t{1, 0, -1}, 0};
+    co_yield {center + vector_t{1, 0, 0}, 0};
+    co_yield {center + vector_t{1, 0, 1}, 0};
+    co_yield {center + vector_t{1, -1, -1}, 0};
+    co_yield {center + vector_t{1, -1, 0}, 0};
+    co_yield {center + vector_t{1, -1, 1}, 0};
+    co_yield {center + vector_t{1, 1, -1}, 0};
+    co_yield {center + vector_t{1, 1, 0}, 0};
+    co_yield {center + vector_t{1, 1, 1}, 0};
+  } else {
+    const auto radius = old_radius / 2;
+    co_yield {center + vector_t{radius, radius, radius}, radius};
+    co_yield {center + vector_t{radius, radius, -radius}, radius};
+    co_yield {center + vector_t{radius, -radius, radius}, radius};
+    co_yield {center + vector_t{radius, -radius, -radius}, radius};
+    co_yield {center + vector_t{-radius, radius, radius}, radius};
+    co_yield {center + vector_t{-radius, radius, -radius}, radius};
+    co_yield {center + vector_t{-radius, -radius, radius}, radius};
+    co_yield {center + vector_t{-radius, -radius, -radius}, radius};
+  }
+}
+
+// Both versions must give the same children. The time each takes to expand
+// every cube down to the unit ones is recorded in the test report, to be
+// compared with --gtest_output=xml.
+TEST(d23, split_search_against_generator) {
+  auto cubes = std::vector<oriented_cube_t>{{ORIGIN, 32}};
+  for (size_t i = 0; i < cubes.size(); ++i) {
+    if (cubes[i].half_size > 1) {
+      auto splits = std::array<oriented_cube_t, MAX_SPLITS>();
+      const size_t count = split_search(cubes[i], splits);
+      cubes.insert(cubes.end(), splits.begin(), splits.begin() + count);
+    }
+  }
+
+  auto timed = [&](auto &&expand) {
+    const auto start = std::chrono::steady_clock::now();
+    value_t checksum = 0;
+    for (const oriented_cube_t &cube : cubes) {
+      checksum += expand(cube);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::make_pair(
+        checksum,
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+  };
+  const auto [span_sum, span_time] = timed([](const oriented_cube_t &cube) {
+    auto splits = std::array<oriented_cube_t, MAX_SPLITS>();
+    const size_t count = split_search(cube, splits);
+    value_t res = 0;
+    for (const oriented_cube_t &child : std::span(splits).first(count)) {
+      res += child.center.x() + 3 * child.center.y() + 7 * child.center.z();
+    }
+    return res;
+  });
+  const auto [generator_sum, generator_time] =
+      timed([](const oriented_cube_t &cube) {
+        value_t res = 0;
+        for (const oriented_cube_t &child : split_search_generator(cube)) {
+          res +=
+              child.center.x() + 3 * child.center.y() + 7 * child.center.z();
+        }
+        return res;
+      });
+  EXPECT_EQ(span_sum, generator_sum);
+  RecordProperty("span_us", static_cast<int>(span_time.count()));
+  RecordProperty("generator_us", static_cast<int>(generator_time.count()));
+
+  // The generator yields the same children in another order
+  auto centers = [](auto &&children) {
+    auto res = std::vector<point_t>();
+    for (const oriented_cube_t &child : children) {
+      res.push_back(child.center);
+    }
+    std::ranges::sort(res);
+    return res;
+  };
+  for (const oriented_cube_t &cube : cubes) {
+    auto splits = std::array<oriented_cube_t, MAX_SPLITS>();
+    const auto children = std::span(splits).first(split_search(cube, splits));
+    ASSERT_EQ(centers(children), centers(split_search_generator(cube)));
+    for (const oriented_cube_t &child : split_search_generator(cube)) {
+      EXPECT_EQ(child.half_size, children.front().half_size);
+    }
+  }
+}
+
+#endif
+
 #endif
\ No newline at end of file
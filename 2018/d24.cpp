@@ -1,25 +1,29 @@
 #include <aoc_lib/algorithm.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/dense_bitset.hpp>
+#include <aoc_lib/interner.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
+#include <limits>
 #include <ranges>
-#include <unordered_set>
 #include <vector>
 
 using std::operator""sv;
 
-// constexpr auto string_hash = [](std::string_view s) { return std::string(s);
-// }; using damage_type_t = std::string;
-constexpr auto string_hash = std::hash<std::string_view>{};
-using damage_type_t = size_t;
+// Damage types are interned into small dense ids
+using damage_type_t = uint8_t;
+using damage_types_t = aoc::interner<damage_type_t>;
+
+constexpr size_t damage_type_count =
+    size_t{std::numeric_limits<damage_type_t>::max()} + 1;
 
 struct effects_t {
-  std::unordered_set<damage_type_t> weaknesses;
-  std::unordered_set<damage_type_t> immunities;
+  aoc::dense_bitset weaknesses{damage_type_count};
+  aoc::dense_bitset immunities{damage_type_count};
 };
 
-effects_t parse_effects(std::string_view input) {
+effects_t parse_effects(std::string_view input, damage_types_t &damage_types) {
   static const auto effect_re =
       std::regex(R"(^(weak|immune) to (\w+(?:, (\w+))*)$)");
 
@@ -31,7 +35,7 @@ effects_t parse_effects(std::string_view input) {
     for (auto type_range : std::views::split(match.str(2), ", "sv)) {
       auto type = std::string_view(type_range);
       if (!type.empty()) {
-        target.insert(string_hash(type));
+        target.insert(damage_types.intern(type));
       }
     }
   }
@@ -61,16 +65,17 @@ struct group_t {
   }
 };
 
-group_t parse_group(std::string_view input, group_t::loyalty_t loyalty) {
+group_t parse_group(std::string_view input, group_t::loyalty_t loyalty,
+                    damage_types_t &damage_types) {
   static const auto group_re = std::regex(
       R"(^(\d+) units each with (\d+) hit points (?:\((.*)\) )?with an attack that does (\d+) (\w+) damage at initiative (\d+)$)");
   auto match = *aoc::regex_match(input, group_re);
   return {.loyalty = loyalty,
           .unit_count = *aoc::from_chars<size_t>(match.str(1)),
           .hit_points = *aoc::from_chars<size_t>(match.str(2)),
-          .effects = parse_effects(match.str(3)),
+          .effects = parse_effects(match.str(3), damage_types),
           .damage_per_unit = *aoc::from_chars<size_t>(match.str(4)),
-          .damage_type = string_hash(match.str(5)),
+          .damage_type = damage_types.intern(match.str(5)),
           .initiative = *aoc::from_chars<size_t>(match.str(6))};
 }
 
@@ -185,14 +190,16 @@ struct d24 {
         R"(^Immune System:\r?\n([^]*)\r?\n\r?\nInfection:\r?\n?([^]*)$)");
 
     auto match = *aoc::regex_match(aoc::trimmed(input), data_re);
+    auto damage_types = damage_types_t{};
     auto sent = std::vector<group_t>();
     sent.append_range(aoc::lines(match.str(1)) |
-                      std::views::transform([](std::string_view l) {
-                        return parse_group(l, group_t::immune_system);
+                      std::views::transform([&](std::string_view l) {
+                        return parse_group(l, group_t::immune_system,
+                                           damage_types);
                       }));
     sent.append_range(aoc::lines(match.str(2)) |
-                      std::views::transform([](std::string_view l) {
-                        return parse_group(l, group_t::infection);
+                      std::views::transform([&](std::string_view l) {
+                        return parse_group(l, group_t::infection, damage_types);
                       }));
 
     size_t immune_count = 0;
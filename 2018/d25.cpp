@@ -1,11 +1,11 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/disjoint_set.hpp>
 #include <aoc_lib/geometry/point.hpp>
+#include <aoc_lib/geometry/point_array.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <ranges>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 using value_t = int64_t;
@@ -29,67 +29,12 @@ struct d25 {
   }
 
   static size_t part1(const data_t &d) {
-    size_t next_constellation = 0;
-    auto point_constellation =
-        std::vector<std::optional<size_t>>(d.size(), std::nullopt);
-    auto all_constellations =
-        std::unordered_map<size_t, std::unordered_set<ptrdiff_t>>();
-
-    auto create_constellation =
-        [&](std::unordered_set<ptrdiff_t> constellation) {
-          for (size_t i : constellation) {
-            point_constellation[i] = next_constellation;
-          }
-          all_constellations.emplace(next_constellation++,
-                                     std::move(constellation));
-        };
-
-    auto merge_constellations = [&](size_t from, size_t to) {
-      if (from != to) {
-        for (ptrdiff_t i : all_constellations[from]) {
-          point_constellation[i] = to;
-        }
-        all_constellations[to].insert_range(all_constellations[from]);
-        all_constellations.erase(from);
-      }
-    };
-
-    auto add_to_constellation = [&](ptrdiff_t i, size_t to) {
-      point_constellation[i] = to;
-      all_constellations[to].insert(i);
-    };
-
-    auto enumarated = d | std::views::enumerate;
-    auto it = std::ranges::begin(enumarated);
-    auto end = std::ranges::end(enumarated);
-    while (it != end) {
-      auto [idx, point] = *it;
-      auto &my_constellation = point_constellation[idx];
-      for (auto [nidx, npoint] : std::ranges::subrange(++it, end)) {
-        if (aoc::manhattan_distance(point, npoint) <= 3) {
-          auto &other_constellation = point_constellation[nidx];
-          if (!my_constellation && !other_constellation) {
-            // Whole new constellation
-            create_constellation({idx, nidx});
-          } else if (!my_constellation && other_constellation) {
-            // Get absorbed in other
-            add_to_constellation(idx, *other_constellation);
-          } else if (my_constellation && !other_constellation) {
-            // Absorb other in my constellation
-            add_to_constellation(nidx, *my_constellation);
-          } else {
-            // Merge both constellations
-            merge_constellations(*my_constellation, *other_constellation);
-          }
-        }
-      }
-      if (!my_constellation) {
-        // Single point constellation
-        create_constellation({idx});
-      }
-    }
-
-    return all_constellations.size();
+    auto constellations = aoc::disjoint_set(d.size());
+    const auto points = aoc::point_array(std::from_range, d);
+    points.for_each_pair_within(
+        3, aoc::metric::manhattan,
+        [&](size_t idx, size_t nidx) { constellations.unite(idx, nidx); });
+    return constellations.components();
   }
 };
 
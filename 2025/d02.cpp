@@ -1,38 +1,34 @@
 #include <aoc_lib/algorithm.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/interval_set.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
+#include <algorithm>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
-struct id_range {
-  size_t from;
-  size_t to;
-
-  bool includes(size_t v) const { return from <= v && v <= to; }
-};
-
 struct d02 {
 
   static auto convert(std::string_view input) {
-    return std::vector{
-        std::from_range,
-        aoc::split(aoc::trimmed(input), ',') |
-            std::views::transform([](std::string_view range) {
-              static const auto re = std::regex(R"((\d+)-(\d+))");
-              const auto match = aoc::regex_match(range, re).value();
-              return id_range{
-                  .from = aoc::from_chars<size_t>(match[1].str()).value(),
-                  .to = aoc::from_chars<size_t>(match[2].str()).value()};
-            })};
+    auto ids = aoc::interval_set<size_t>{};
+    for (std::string_view range : aoc::split(aoc::trimmed(input), ',')) {
+      static const auto re = std::regex(R"((\d+)-(\d+))");
+      const auto match = aoc::regex_match(range, re).value();
+      ids.insert(aoc::from_chars<size_t>(match[1].str()).value(),
+                 aoc::from_chars<size_t>(match[2].str()).value());
+    }
+    return ids;
   }
 
-  static auto run(const auto &input) {
-    auto max = std::ranges::max(input | std::views::transform(&id_range::to));
-    auto part1 = std::unordered_set<size_t>{};
-    auto part2 = std::unordered_set<size_t>{};
+  static auto run(const aoc::interval_set<size_t> &input) {
+    auto max = std::prev(input.end())->second;
+
+    // Each id made of a sequence repeated twice is generated once, but ids
+    // may be generated several times overall, e.g. 1111 from 1 and 11. Only
+    // the ids found are kept, to be deduplicated at the end.
+    auto part1 = 0uz;
+    auto found = std::vector<size_t>{};
     auto magnitude = 10uz;
     for (size_t i = 1; true; ++i) {
       while (magnitude <= i) {
@@ -43,18 +39,20 @@ struct d02 {
         break;
       }
       for (auto repeat = 2uz; val <= max; ++repeat) {
-        if (std::ranges::any_of(input, [val](const auto &range) {
-              return range.includes(val);
-            })) {
+        if (input.contains(val)) {
           if (repeat == 2) {
-            part1.insert(val);
+            part1 += val;
           }
-          part2.insert(val);
+          found.push_back(val);
         }
         val = val * magnitude + i;
       }
     }
-    return std::make_pair(aoc::sum(part1).value(), aoc::sum(part2).value());
+    std::ranges::sort(found);
+    const auto [last, end] = std::ranges::unique(found);
+    found.erase(last, end);
+    const auto part2 = aoc::sum(found).value_or(0);
+    return std::make_pair(part1, part2);
   }
 };
 
@@ -1,5 +1,6 @@
 #include <aoc_lib/algorithm.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/geometry/grid_input.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <cassert>
@@ -9,19 +10,7 @@
 struct d03 {
 
   static auto convert(const std::string &input) {
-    return std::vector{
-        std::from_range,
-        aoc::lines(aoc::trimmed(input)) |
-            std::views::transform([](std::string_view line) {
-              return std::vector{
-                  std::from_range,
-                  aoc::trimmed(line) | std::views::transform([](char c) {
-                    if (c < '0' || c > '9') {
-                      throw std::runtime_error("Invalid digit");
-                    }
-                    return static_cast<uint8_t>(c - '0');
-                  })};
-            })};
+    return aoc::digit_grid(input);
   }
 
   template <size_t N>
@@ -59,15 +48,17 @@ struct d03 {
   }
 
   static auto part1(const auto &input) {
-    return aoc::sum(input | std::views::transform([](const auto &row) {
-                      return max_voltage<2>(std::span(row));
+    return aoc::sum(input.rows() |
+                    std::views::transform([](std::span<const uint8_t> row) {
+                      return max_voltage<2>(row);
                     }))
         .value();
   }
 
   static auto part2(const auto &input) {
-    return aoc::sum(input | std::views::transform([](const auto &row) {
-                      return max_voltage<12>(std::span(row));
+    return aoc::sum(input.rows() |
+                    std::views::transform([](std::span<const uint8_t> row) {
+                      return max_voltage<12>(row);
                     }))
         .value();
   }
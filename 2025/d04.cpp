@@ -1,65 +1,47 @@
 #include <aoc_lib/day_trait.hpp>
 #include <aoc_lib/geometry/algorithm.hpp>
-#include <aoc_lib/geometry/dyn_matrix.hpp>
+#include <aoc_lib/geometry/bit_matrix.hpp>
+#include <aoc_lib/geometry/grid_input.hpp>
+#include <aoc_lib/geometry/stencil.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 
-using map = aoc::dyn_matrix<char>;
+using map = aoc::bit_matrix;
 
-struct d04 {
-  static map convert(const std::string &input) {
-    return aoc::dyn_matrix(std::from_range, aoc::lines(aoc::trimmed(input)));
-  }
+constexpr auto ALPHABET = aoc::grid_alphabet(".@");
+constexpr auto ROLL = ALPHABET.code('@');
 
-  static size_t count_neighbours(const map &input, const map::point_t &point) {
-    return std::ranges::count_if(
-        aoc::adjacent(aoc::adjacent_type::euclidean,
-                      aoc::point2d<std::ptrdiff_t>(point)),
-        [&input](const auto &a) {
-          return a.x() >= 0 && a.y() >= 0 && input.contains(a) &&
-                 input[a] == '@';
-        });
-  }
+// Rolls with at least 4 neighbouring rolls stay, the others are removed
+constexpr auto REMOVAL = aoc::count_rule{.survives = 0b1'1111'0000};
 
-  static auto run(const map &input) {
-    auto to_remove = std::unordered_set<map::point_t>{};
-    auto cannot_remove = std::unordered_map<map::point_t, size_t>{};
-    auto removed = std::unordered_set<map::point_t>{};
-
-    for (const auto &[p, v] : input.enumerate()) {
-      if (v == '@') {
-        const auto neighbors = count_neighbours(input, p);
-        if (neighbors < 4) {
-          to_remove.insert(p);
-        } else {
-          cannot_remove.insert_or_assign(p, neighbors);
-        }
+struct d04 {
+  static map convert(const std::string &input) {
+    const auto cells = aoc::char_grid(input, ALPHABET);
+    auto res = map(cells.width(), cells.height());
+    for (size_t m = 0; m < cells.height(); ++m) {
+      for (size_t n = 0; n < cells.width(); ++n) {
+        res.set(m, n, cells[m, n] == ROLL);
       }
     }
+    return res;
+  }
 
-    size_t first_removal = to_remove.size();
-
-    while (!to_remove.empty()) {
-      for (const map::point_t &cur : std::exchange(to_remove, {})) {
-        if (removed.insert(cur).second) {
-          for (auto a : aoc::adjacent(aoc::adjacent_type::euclidean,
-                                      aoc::point2d<ptrdiff_t>(cur))) {
-            auto found = cannot_remove.find(a);
-            if (found != cannot_remove.end()) {
-              if (--found->second < 4) {
-                to_remove.insert(found->first);
-                cannot_remove.erase(found);
-              }
-            }
-          }
-        }
-      }
+  static auto run(const map &input) {
+    // Removing rolls in rounds rather than one at a time reaches the same
+    // state, since a roll that can be removed stays removable.
+    auto rolls = aoc::bit_stencil(input);
+    rolls.step(aoc::adjacent_type::euclidean, REMOVAL);
+    const size_t first_removal = input.count() - rolls.grid().count();
+
+    size_t remaining = input.count();
+    while (rolls.grid().count() != remaining) {
+      remaining = rolls.grid().count();
+      rolls.step(aoc::adjacent_type::euclidean, REMOVAL);
     }
 
-    return std::make_pair(first_removal, removed.size());
+    return std::make_pair(first_removal, input.count() - remaining);
   }
 };
 
@@ -1,48 +1,49 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/flat_set.hpp>
 #include <aoc_lib/geometry/dyn_matrix.hpp>
+#include <aoc_lib/geometry/grid_input.hpp>
 #include <aoc_lib/geometry/vector.hpp>
+#include <aoc_lib/memo.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 
 #include <aoc_lib/geometry_format.hpp>
 #include <print>
 
-using input_t = aoc::dyn_matrix<char>;
+using input_t = aoc::dyn_matrix<uint8_t>;
 using point_t = input_t::point_t;
 
+constexpr auto ALPHABET = aoc::grid_alphabet(".^S");
+constexpr auto SPLITTER = ALPHABET.code('^');
+constexpr auto START = ALPHABET.code('S');
+
 struct d07 {
 
   static auto convert(const std::string &input) -> input_t {
-    return {std::from_range, aoc::lines(aoc::trimmed(input))};
+    return aoc::char_grid(input, ALPHABET);
   }
 
+  // Timelines of a beam going down from start, given those of the beams it
+  // splits into
   static auto count_timelines_from(const input_t &input, point_t start,
-                                   std::unordered_set<point_t> &split_points,
-                                   std::unordered_map<point_t, size_t> &cache) {
-    if (auto found = cache.find(start); found != cache.end()) {
-      return found->second;
-    }
+                                   aoc::flat_set<point_t> &split_points,
+                                   auto &&timelines_from) {
     auto cur = start;
     do {
       cur.y() += 1;
-    } while (cur.y() < input.height() && input[cur] != '^');
+    } while (cur.y() < input.height() && input[cur] != SPLITTER);
     if (cur.y() >= input.height()) {
       return 1uz;
     }
     split_points.insert(cur);
     auto res = 0uz;
     if (cur.x() > 0) {
-      res += count_timelines_from(input, {cur.x() - 1, cur.y()}, split_points,
-                                  cache);
+      res += timelines_from(point_t{cur.x() - 1, cur.y()});
     }
     if (cur.x() < input.width() - 1) {
-      res += count_timelines_from(input, {cur.x() + 1, cur.y()}, split_points,
-                                  cache);
+      res += timelines_from(point_t{cur.x() + 1, cur.y()});
     }
-    cache.insert_or_assign(start, res);
     return res;
   }
 
@@ -50,11 +51,17 @@ struct d07 {
     auto start =
         point_t{*std::ranges::find_if(
                     std::views::iota(0uz, input.width()),
-                    [&input](size_t x) { return input[{x, 0}] == 'S'; }),
+                    [&input](size_t x) { return input[{x, 0}] == START; }),
                 0};
-    auto split_points = std::unordered_set<point_t>{};
-    auto cache = std::unordered_map<point_t, size_t>{};
-    auto part2 = count_timelines_from(input, start, split_points, cache);
+    auto split_points = aoc::flat_set<point_t>{};
+    auto timelines = aoc::make_memo<point_t, size_t>(
+        input.width() * input.height(),
+        [&input](point_t p) { return p.y() * input.width() + p.x(); });
+    auto part2 = timelines.recursive(
+        start, [&](point_t from, auto &&timelines_from) {
+          return count_timelines_from(input, from, split_points,
+                                      timelines_from);
+        });
     return std::make_pair(split_points.size(), part2);
   }
 };
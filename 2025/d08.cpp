@@ -1,10 +1,12 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/disjoint_set.hpp>
+#include <aoc_lib/geometry/kd_tree.hpp>
 #include <aoc_lib/geometry/point.hpp>
 #include <aoc_lib/string.hpp>
 
 #include <functional>
+#include <optional>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 #include <aoc_lib/geometry_format.hpp>
@@ -12,6 +14,7 @@
 
 using point_t = aoc::point3d<int64_t>;
 using input_t = std::pair<size_t, std::vector<point_t>>;
+using tree_t = aoc::kd_tree<int64_t, 3>;
 
 struct d08 {
 
@@ -34,62 +37,71 @@ struct d08 {
   static auto run(const input_t &in) {
     struct heap_elem_t {
       int64_t dist;
-      point_t from, to;
+      size_t from, to;
 
       constexpr auto operator<=>(const heap_elem_t &) const = default;
     };
 
     auto [to_take, input] = in;
 
-    auto circuits = std::vector<std::unordered_set<point_t>>{
-        std::from_range, input | std::views::transform([](const point_t &p) {
-                           return std::unordered_set{p};
-                         })};
+    auto circuits = aoc::disjoint_set(input.size());
+
+    // Rather than computing all the pairs up front, each point streams its
+    // neighbours by increasing distance, fetching twice as many from the tree
+    // once the previous ones are consumed. Only the edges towards a higher
+    // index are kept so that each edge is produced once.
+    const auto tree = tree_t(std::from_range, input);
+    auto neighbours =
+        std::vector<std::vector<tree_t::neighbour_t>>(input.size());
+    auto consumed = std::vector<size_t>(input.size());
+    auto next_edge = [&](size_t from) -> std::optional<heap_elem_t> {
+      auto &fetched = neighbours[from];
+      while (true) {
+        if (consumed[from] == fetched.size()) {
+          if (fetched.size() == input.size()) {
+            return std::nullopt;
+          }
+          fetched = tree.nearest(input[from], std::max(2 * fetched.size(), 8uz),
+                                 aoc::metric::squared_euclidean);
+        }
+        auto [to, dist] = fetched[consumed[from]++];
+        if (to > from) {
+          return heap_elem_t{dist, from, to};
+        }
+      }
+    };
+
     auto distance_heap = std::vector<heap_elem_t>{};
-    distance_heap.reserve(input.size() * input.size());
-    for (auto it = input.begin(); it != input.end(); ++it) {
-      for (auto next = it + 1; next != input.end(); ++next) {
-        distance_heap.push_back(heap_elem_t{
-            aoc::squared_euclidean_distance(*it, *next), *it, *next});
-        std::ranges::push_heap(distance_heap, std::greater{});
+    for (size_t from = 0; from < input.size(); ++from) {
+      if (auto edge = next_edge(from)) {
+        distance_heap.push_back(*edge);
       }
     }
+    std::ranges::make_heap(distance_heap, std::greater{});
+
     size_t part1 = 0, part2 = 0;
     for (size_t i = 1; !distance_heap.empty(); ++i) {
       std::ranges::pop_heap(distance_heap, std::greater{});
-      auto &c = distance_heap.back();
-      auto new_circuit = std::unordered_set{c.from, c.to};
-      new_circuit.reserve(input.size());
-      for (auto it = circuits.begin(); it != circuits.end();) {
-        if (std::ranges::any_of(new_circuit, [&it](const point_t &p) {
-              return it->contains(p);
-            })) {
-          new_circuit.merge(*it);
-          it = circuits.erase(it);
-        } else {
-          ++it;
-        }
+      const auto c = distance_heap.back();
+      distance_heap.pop_back();
+      if (auto edge = next_edge(c.from)) {
+        distance_heap.push_back(*edge);
+        std::ranges::push_heap(distance_heap, std::greater{});
       }
-      circuits.push_back(std::move(new_circuit));
+
+      circuits.unite(c.from, c.to);
 
       // Part 1
       if (i == to_take) {
-        auto sizes =
-            std::vector{std::from_range,
-                        circuits | std::views::transform(
-                                       &std::unordered_set<point_t>::size)};
-        std::ranges::sort(sizes, std::greater{});
-        part1 = std::ranges::fold_left(sizes | std::views::take(3), 1uz,
+        part1 = std::ranges::fold_left(circuits.largest_components(3), 1uz,
                                        std::multiplies{});
       }
 
       // Part 2
-      if (circuits.size() == 1) {
-        part2 = c.from.x() * c.to.x();
+      if (circuits.components() == 1) {
+        part2 = input[c.from].x() * input[c.to].x();
         break;
       }
-
-      distance_heap.pop_back();
     }
     return std::make_pair(part1, part2);
   }
@@ -1,6 +1,8 @@
 #include <aoc_lib/algorithm.hpp>
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/dijkstra.hpp>
 #include <aoc_lib/hash.hpp>
+#include <aoc_lib/parallel.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
@@ -10,7 +12,6 @@
 #include <iostream>
 #include <print>
 #include <string>
-#include <unordered_map>
 
 using value_t = uint16_t;
 using joltage_t = std::array<value_t, sizeof(value_t) * 8>;
@@ -90,74 +91,58 @@ struct d10 {
             })};
   }
 
+  // Machines are independent, so both parts solve them in parallel
   static auto part1(const input_t &input) {
-    return aoc::sum(
-               input | std::views::transform([](const machine_t &machine) {
-                 auto start = value_t{0};
-                 auto dist = std::unordered_map<value_t, size_t>{{start, 0}};
-                 auto to_visit =
-                     std::vector<std::pair<size_t, value_t>>{{0, start}};
-
-                 while (!to_visit.empty()) {
-                   std::ranges::pop_heap(to_visit, std::greater{});
-                   auto [cur_dist, cur] = to_visit.back();
-                   to_visit.pop_back();
-                   if (cur_dist > dist[cur]) {
-                     continue;
-                   }
-
-                   auto next_dist = cur_dist + 1;
-                   for (value_t button : machine.buttons) {
-                     auto next = static_cast<value_t>(cur ^ button);
-                     if (auto found = dist.find(next);
-                         found == dist.end() || found->second > next_dist) {
-                       dist.insert_or_assign(next, next_dist);
-                       to_visit.push_back({next_dist, next});
-                       std::ranges::push_heap(to_visit, std::greater{});
-                     }
-                   }
-                 }
-                 return dist.at(machine.target);
-               }))
-        .value();
+    return aoc::parallel_transform_reduce(
+        input, size_t{0}, std::plus<>(), [](const machine_t &machine) {
+          auto presses = aoc::dijkstra(
+              value_t{0}, 1,
+              [&machine](value_t cur, auto &&visit) {
+                for (value_t button : machine.buttons) {
+                  visit(static_cast<value_t>(cur ^ button), 1);
+                }
+              },
+              [&machine](value_t cur) { return cur == machine.target; });
+          return presses.value();
+        });
   }
 
   static auto part2(const input_t &input) {
-    return aoc::sum(
-               input | std::views::transform([](const machine_t &machine) {
-                 auto c = z3::context{};
-                 auto o = z3::optimize(c);
-                 auto dependencies = std::vector<z3::expr_vector>{};
-                 for (size_t i = 0; i < machine.joltage.size(); ++i) {
-                   dependencies.push_back(z3::expr_vector(c));
-                 }
-                 auto buttons = z3::expr_vector(c);
-                 for (auto [bi, b] : machine.buttons | std::views::enumerate) {
-                   auto button = c.int_const(std::format("b{}", bi).c_str());
-                   o.add(button >= 0);
-                   for (value_t i = 0; i < dependencies.size(); ++i) {
-                     if ((b & (1 << i)) != 0) {
-                       dependencies[i].push_back(button);
-                     }
-                   }
-                   buttons.push_back(std::move(button));
-                 }
-                 for (size_t i = 0; i < dependencies.size(); ++i) {
-                   auto s = c.int_const(std::format("s{}", i).c_str());
-                   o.add(s == static_cast<int>(machine.joltage[i]));
-                   if (!dependencies[i].empty()) {
-                     o.add(s == z3::sum(dependencies[i]));
-                   }
-                 }
-                 auto sum = c.int_const("sum");
-                 o.add(sum == z3::sum(buttons));
-                 o.minimize(sum);
-                 if (o.check() != z3::sat) {
-                   throw std::runtime_error("Failed to satisfy model");
-                 }
-                 return o.get_model().eval(sum).as_uint64();
-               }))
-        .value();
+    return aoc::parallel_transform_reduce(
+        input, uint64_t{0}, std::plus<>(), [](const machine_t &machine) {
+          // Each thread needs its own context
+          auto c = z3::context{};
+          auto o = z3::optimize(c);
+          auto dependencies = std::vector<z3::expr_vector>{};
+          for (size_t i = 0; i < machine.joltage.size(); ++i) {
+            dependencies.push_back(z3::expr_vector(c));
+          }
+          auto buttons = z3::expr_vector(c);
+          for (auto [bi, b] : machine.buttons | std::views::enumerate) {
+            auto button = c.int_const(std::format("b{}", bi).c_str());
+            o.add(button >= 0);
+            for (value_t i = 0; i < dependencies.size(); ++i) {
+              if ((b & (1 << i)) != 0) {
+                dependencies[i].push_back(button);
+              }
+            }
+            buttons.push_back(std::move(button));
+          }
+          for (size_t i = 0; i < dependencies.size(); ++i) {
+            auto s = c.int_const(std::format("s{}", i).c_str());
+            o.add(s == static_cast<int>(machine.joltage[i]));
+            if (!dependencies[i].empty()) {
+              o.add(s == z3::sum(dependencies[i]));
+            }
+          }
+          auto sum = c.int_const("sum");
+          o.add(sum == z3::sum(buttons));
+          o.minimize(sum);
+          if (o.check() != z3::sat) {
+            throw std::runtime_error("Failed to satisfy model");
+          }
+          return o.get_model().eval(sum).as_uint64();
+        });
   }
 };
 
@@ -1,11 +1,13 @@
 #include <aoc_lib/day_trait.hpp>
+#include <aoc_lib/interner.hpp>
+#include <aoc_lib/memo.hpp>
 #include <aoc_lib/regex.hpp>
+#include <aoc_lib/small_vector.hpp>
 #include <aoc_lib/string.hpp>
 
+#include <algorithm>
 #include <print>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 
 using namespace std::literals::string_view_literals;
 
@@ -17,21 +19,18 @@ constexpr auto SVR = id_t{2};
 constexpr auto DAC = id_t{3};
 constexpr auto FFT = id_t{4};
 
-using input_t = std::vector<std::unordered_set<uint16_t>>;
+// Out-edges of each node, of which there are only a handful
+using input_t = std::vector<aoc::small_vector<id_t, 6>>;
 
-size_t paths_to_out(id_t from, const input_t &graph,
-                    std::unordered_map<id_t, size_t> &cache) {
+// Paths from a node, given the paths from the nodes after it
+size_t paths_to_out(id_t from, const input_t &graph, auto &&paths_from) {
   if (from == OUT) {
     return 1;
   }
-  if (auto found = cache.find(from); found != cache.end()) {
-    return found->second;
-  }
   auto res = 0uz;
   for (id_t next : graph[from]) {
-    res += paths_to_out(next, graph, cache);
+    res += paths_from(next);
   }
-  cache.insert_or_assign(from, res);
   return res;
 }
 
@@ -44,6 +43,9 @@ public:
   void set_dac() { m_state |= (1 << sizeof(id_t) * 8); }
   void set_fft() { m_state |= (1 << ((sizeof(id_t) * 8) + 1)); }
 
+  // Index among the states of a graph of n nodes, below 4 * n
+  size_t index() const { return (m_state & 0x0000FFFF) << 2 | m_state >> 16; }
+
   traversal_state_t next(id_t id) const {
     return {from_state, (m_state & 0xFFFF0000) | id};
   }
@@ -57,17 +59,10 @@ private:
   traversal_state_t(from_state_t, uint32_t state) : m_state(state) {}
 
   uint32_t m_state{};
-
-  friend struct std::hash<traversal_state_t>;
 };
 
-template <> struct std::hash<traversal_state_t> {
-  size_t operator()(traversal_state_t t) const { return t.m_state; }
-};
-
-size_t
-paths_to_dac_fft_out(traversal_state_t from, const input_t &graph,
-                     std::unordered_map<traversal_state_t, size_t> &cache) {
+size_t paths_to_dac_fft_out(traversal_state_t from, const input_t &graph,
+                            auto &&paths_from) {
   if (from.id() == OUT) {
     return from.is_final();
   }
@@ -76,31 +71,22 @@ paths_to_dac_fft_out(traversal_state_t from, const input_t &graph,
   } else if (from.id() == FFT) {
     from.set_fft();
   }
-  if (auto found = cache.find(from); found != cache.end()) {
-    return found->second;
-  }
   auto res = 0uz;
   for (id_t next : graph[from.id()]) {
-    res += paths_to_dac_fft_out(from.next(next), graph, cache);
+    res += paths_from(from.next(next));
   }
-  cache.insert_or_assign(from, res);
   return res;
 }
 
 struct d11 {
 
   static auto convert(const std::string &input) -> input_t {
-    auto id_labels =
-        std::vector<std::string_view>{"you", "out", "svr", "dac", "fft"};
-    auto res = input_t{5};
-
-    auto get_id = [&id_labels](std::string_view label) {
-      auto it = std::ranges::find(id_labels, label);
-      if (it == id_labels.end()) {
-        id_labels.push_back(label);
-        return static_cast<id_t>(id_labels.size() - 1);
-      }
-      return static_cast<id_t>(it - id_labels.begin());
+    // Interned first, so that they get the ids of the constants above
+    auto labels = aoc::interner<id_t>{"you", "out", "svr", "dac", "fft"};
+    auto res = input_t{labels.size()};
+
+    auto get_id = [&labels](std::string_view label) {
+      return labels.intern(label);
     };
 
     for (std::string_view line : aoc::lines(aoc::trimmed(input))) {
@@ -112,19 +98,35 @@ struct d11 {
       }
       res[cur] = {std::from_range, aoc::split(aoc::trimmed(*it), ' ') |
                                        std::views::transform(get_id)};
+      auto &edges = res[cur];
+      // A repeated edge would count the paths through it twice
+      std::ranges::sort(edges);
+      const auto duplicates = std::ranges::unique(edges);
+      while (edges.end() != duplicates.begin()) {
+        edges.pop_back();
+      }
     }
+    // Nodes only seen as targets have no out-edges
+    res.resize(labels.size());
 
     return res;
   }
 
+  // Paths can be as long as the graph, so they are counted without recursion
   static auto part1(const input_t &input) {
-    auto cache = std::unordered_map<id_t, size_t>{};
-    return paths_to_out(YOU, input, cache);
+    auto paths = aoc::make_memo<id_t, size_t>(input.size(), std::identity());
+    return paths.iterative(YOU, [&input](id_t from, auto &&paths_from) {
+      return paths_to_out(from, input, paths_from);
+    });
   }
 
   static auto part2(const input_t &input) {
-    auto cache = std::unordered_map<traversal_state_t, size_t>{};
-    return paths_to_dac_fft_out(SVR, input, cache);
+    auto paths = aoc::make_memo<traversal_state_t, size_t>(
+        4 * input.size(), &traversal_state_t::index);
+    return paths.iterative(
+        SVR, [&input](traversal_state_t from, auto &&paths_from) {
+          return paths_to_dac_fft_out(from, input, paths_from);
+        });
   }
 };
 
@@ -152,6 +154,14 @@ iii: out
 
 TEST(d11, part1) { EXPECT_EQ(aoc::part1<d11>(TEST_DATA), 5); }
 
+TEST(d11, part1_repeated_edges) {
+  EXPECT_EQ(aoc::part1<d11>(aoc::arguments::make_example(R"(you: aaa bbb aaa
+aaa: out out
+bbb: aaa
+)")),
+            2);
+}
+
 const auto TEST_DATA_2 = aoc::arguments::make_example(R"(svr: aaa bbb
 aaa: fft
 fft: ccc
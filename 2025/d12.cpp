@@ -1,6 +1,6 @@
 #include <aoc_lib/algorithm.hpp>
 #include <aoc_lib/day_trait.hpp>
-#include <aoc_lib/geometry/fixed_matrix.hpp>
+#include <aoc_lib/geometry/bit_matrix.hpp>
 #include <aoc_lib/regex.hpp>
 #include <aoc_lib/string.hpp>
 
@@ -12,7 +12,7 @@
 
 using namespace std::literals::string_view_literals;
 
-using shape_t = aoc::fixed_matrix<bool, 3, 3>;
+using shape_t = aoc::bit_matrix;
 
 struct region_t {
   size_t width, height;
@@ -36,12 +36,12 @@ struct d12 {
           std::regex(R"(^(\d+)x(\d+):((?: \d+)+)$)");
 
       if (auto shape_match = aoc::regex_match(*it, SHAPE_PATTERN)) {
-        auto shape = shape_t{};
+        auto shape = shape_t{3, 3};
         for (size_t j = 0; j < 3; ++j) {
           std::string_view shape_line = *++it;
           assert(shape_line.size() == 3);
           for (size_t i = 0; i < 3; ++i) {
-            shape.at(j, i) = shape_line[i] == '#';
+            shape.set(j, i, shape_line[i] == '#');
           }
         }
         shapes.push_back(std::move(shape));
@@ -69,10 +69,7 @@ struct d12 {
 
   static auto part1(const input_t &input) {
     auto shape_sizes = std::vector{
-        std::from_range,
-        input.shapes | std::views::transform([](const shape_t &shape) {
-          return std::ranges::count(shape.data(), true);
-        })};
+        std::from_range, input.shapes | std::views::transform(&shape_t::count)};
     return std::ranges::count_if(input.regions, [&input, &shape_sizes](
                                                     const region_t &region) {
       auto total_coverage =
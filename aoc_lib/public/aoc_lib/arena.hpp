@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace aoc {
+
+// Bump allocator: memory is handed out from large chunks, each one twice as
+// large as the previous one, and only given back all at once by release() or
+// on destruction. Deallocating does nothing. Allocations are serialized by a
+// mutex, so that containers on several threads can share an arena, but
+// release() must not race with them.
+class arena : public std::pmr::memory_resource {
+public:
+  explicit arena(size_t initial_chunk_size = 64 * 1024);
+  arena(const arena &) = delete;
+  arena &operator=(const arena &) = delete;
+  ~arena() override;
+
+  // Frees every chunk. Memory allocated so far must not be used anymore.
+  void release();
+
+  // Bytes handed out since construction or the last release
+  size_t allocated() const { return m_allocated; }
+
+private:
+  struct chunk_t {
+    std::byte *data;
+    size_t size;
+  };
+
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *, size_t, size_t) override {}
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  void add_chunk(size_t min_size);
+
+  std::mutex m_mutex;
+  std::vector<chunk_t> m_chunks;
+  std::byte *m_current = nullptr;
+  size_t m_remaining = 0;
+  size_t m_next_chunk_size;
+  size_t m_allocated = 0;
+};
+
+} // namespace aoc
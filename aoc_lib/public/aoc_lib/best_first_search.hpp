@@ -0,0 +1,180 @@
+#pragma once
+
+#include <aoc_lib/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+namespace detail {
+// Relaxed priority queue shared by several threads: a set of heaps, each with
+// its own lock. Values are pushed on a random heap, and popped from the best
+// of two random ones, so what comes out is close to the best value without
+// every thread contending on the same lock.
+template <typename T, typename Less> class multi_queue {
+public:
+  multi_queue(size_t heaps, Less less) : m_less(std::move(less)) {
+    for (size_t i = 0; i < heaps; ++i) {
+      m_heaps.push_back(std::make_unique<heap_t>());
+    }
+  }
+
+  template <typename Rng> void push(T value, Rng &rng) {
+    heap_t &heap = *m_heaps[rng() % m_heaps.size()];
+    std::lock_guard lock(heap.mutex);
+    heap.values.push_back(std::move(value));
+    std::ranges::push_heap(heap.values, greater());
+  }
+
+  // nullopt only if every heap was found empty
+  template <typename Rng> std::optional<T> pop(Rng &rng) {
+    const size_t a = rng() % m_heaps.size();
+    const size_t b = rng() % m_heaps.size();
+    if (a == b) {
+      std::lock_guard lock(m_heaps[a]->mutex);
+      if (!m_heaps[a]->values.empty()) {
+        return take(*m_heaps[a]);
+      }
+    } else {
+      std::scoped_lock lock(m_heaps[a]->mutex, m_heaps[b]->mutex);
+      if (heap_t *best = better(*m_heaps[a], *m_heaps[b])) {
+        return take(*best);
+      }
+    }
+    // Both picks were empty, the search may be winding down
+    for (size_t i = 0; i < m_heaps.size(); ++i) {
+      heap_t &heap = *m_heaps[(a + i) % m_heaps.size()];
+      std::lock_guard lock(heap.mutex);
+      if (!heap.values.empty()) {
+        return take(heap);
+      }
+    }
+    return std::nullopt;
+  }
+
+private:
+  struct heap_t {
+    std::mutex mutex;
+    std::vector<T> values;
+  };
+
+  // Heaps keep their best value in front
+  auto greater() const {
+    return [this](const T &l, const T &r) { return m_less(r, l); };
+  }
+
+  heap_t *better(heap_t &l, heap_t &r) const {
+    if (l.values.empty() || r.values.empty()) {
+      return l.values.empty() ? (r.values.empty() ? nullptr : &r) : &l;
+    }
+    return m_less(r.values.front(), l.values.front()) ? &r : &l;
+  }
+
+  T take(heap_t &heap) const {
+    std::ranges::pop_heap(heap.values, greater());
+    T res = std::move(heap.values.back());
+    heap.values.pop_back();
+    return res;
+  }
+
+  std::vector<std::unique_ptr<heap_t>> m_heaps;
+  Less m_less;
+};
+} // namespace detail
+
+// Best node matching goal(node) below root, as ranked by less, or nullopt if
+// there is none. expand(node, push) calls push(child) for every child of a
+// node that is not a goal.
+//
+// This is a branch and bound search: nodes are explored best first, and those
+// not better than the best goal found so far are dropped with their subtree.
+// less must thus never rank a node after a goal below it, which makes the
+// ranking of a node a bound on its goals.
+//
+// The search runs on every thread of the current thread_pool, sharing a
+// relaxed priority queue. Nodes are not explored in exact order, but every
+// node better than the result is, so that it is the one a serial search
+// finds, up to goals ranked equal. expand and goal must be safe to call
+// concurrently.
+template <typename Node, typename Expand, std::predicate<const Node &> Goal,
+          typename Less = std::less<>>
+std::optional<Node> best_first_search(Node root, Expand expand, Goal goal,
+                                      Less less = {}) {
+  const size_t workers = concurrency();
+  // A single heap keeps the order exact when running serially
+  auto to_visit =
+      detail::multi_queue<Node, Less>(workers == 1 ? 1 : workers * 2, less);
+  // Nodes queued or being expanded
+  std::atomic<size_t> pending = 1;
+  std::atomic<bool> failed = false;
+  // Goals are published under the lock, and workers refresh their own copy
+  // of the best one whenever the generation changes
+  std::mutex best_mutex;
+  std::optional<Node> best;
+  std::atomic<size_t> best_generation = 0;
+
+  {
+    auto rng = std::minstd_rand();
+    to_visit.push(std::move(root), rng);
+  }
+  parallel_for(workers, [&](size_t worker) {
+    auto rng = std::minstd_rand(
+        static_cast<std::minstd_rand::result_type>(worker + 1));
+    std::optional<Node> known_best;
+    size_t known_generation = 0;
+    auto improves = [&](const Node &node) {
+      if (best_generation.load(std::memory_order_acquire) !=
+          known_generation) {
+        std::lock_guard lock(best_mutex);
+        known_best = best;
+        known_generation = best_generation.load(std::memory_order_relaxed);
+      }
+      return !known_best || std::invoke(less, node, *known_best);
+    };
+    auto push = [&](Node child) {
+      if (improves(child)) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        to_visit.push(std::move(child), rng);
+      }
+    };
+    try {
+      while (pending.load(std::memory_order_acquire) != 0 && !failed) {
+        std::optional<Node> cur = to_visit.pop(rng);
+        if (!cur) {
+          // Other workers are still expanding the last nodes
+          std::this_thread::yield();
+          continue;
+        }
+        if (!improves(*cur)) {
+          // A better goal was found since it was queued
+        } else if (std::invoke(goal, std::as_const(*cur))) {
+          std::lock_guard lock(best_mutex);
+          if (!best || std::invoke(less, *cur, *best)) {
+            best = std::move(*cur);
+            best_generation.fetch_add(1, std::memory_order_release);
+          }
+        } else {
+          std::invoke(expand, std::as_const(*cur), push);
+        }
+        pending.fetch_sub(1, std::memory_order_release);
+      }
+    } catch (...) {
+      failed = true;
+      throw;
+    }
+  });
+  return best;
+}
+
+} // namespace aoc
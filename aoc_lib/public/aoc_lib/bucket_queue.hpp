@@ -0,0 +1,55 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Priority queue for small integer keys that never go below the last key
+// popped, as in Dijkstra's algorithm with integer weights. Pending keys lie
+// in a window [current, current + span) mapped on a ring of buckets, so that
+// pushing and popping are O(1) amortized. span has to be larger than the
+// difference between any key pushed and the last key popped, e.g. the
+// largest edge weight plus one.
+//
+// Values with the same key come out last in, first out.
+template <typename T> class bucket_queue {
+public:
+  explicit bucket_queue(size_t span) : m_buckets(std::bit_ceil(span)) {}
+
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+
+  void push(size_t key, T value) {
+    assert(key >= m_current && key - m_current < m_buckets.size());
+    bucket(key).push_back(std::move(value));
+    ++m_size;
+  }
+
+  // Removes a value with the smallest key, and returns both
+  std::pair<size_t, T> pop() {
+    assert(!empty());
+    while (bucket(m_current).empty()) {
+      ++m_current;
+    }
+    auto &values = bucket(m_current);
+    auto res = std::pair<size_t, T>{m_current, std::move(values.back())};
+    values.pop_back();
+    --m_size;
+    return res;
+  }
+
+private:
+  std::vector<T> &bucket(size_t key) {
+    return m_buckets[key & (m_buckets.size() - 1)];
+  }
+
+  std::vector<std::vector<T>> m_buckets;
+  size_t m_current = 0;
+  size_t m_size = 0;
+};
+
+} // namespace aoc
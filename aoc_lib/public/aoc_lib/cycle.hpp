@@ -0,0 +1,86 @@
+#pragma once
+
+#include <aoc_lib/flat_map.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace aoc {
+
+// The states reached from an initial state by repeatedly applying a step end
+// up looping: the state after `start` steps comes back every `length` steps.
+struct cycle_info {
+  size_t start = 0;
+  size_t length = 0;
+
+  // Smallest number of steps leading to the same state as n steps
+  constexpr size_t index_of(size_t n) const {
+    return n < start ? n : start + (n - start) % length;
+  }
+};
+
+// The state after `count` applications of step
+template <std::copyable State, std::invocable<State &> Step>
+State advance(State state, Step step, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    std::invoke(step, state);
+  }
+  return state;
+}
+
+// Brent's algorithm: only keeps two states around, but goes through the steps
+// about three times.
+template <std::copyable State, std::invocable<State &> Step>
+  requires std::equality_comparable<State>
+cycle_info find_cycle(const State &initial, Step step) {
+  size_t power = 1;
+  size_t length = 1;
+  State tortoise = initial;
+  State hare = initial;
+  std::invoke(step, hare);
+  while (tortoise != hare) {
+    if (power == length) {
+      tortoise = hare;
+      power *= 2;
+      length = 0;
+    }
+    std::invoke(step, hare);
+    ++length;
+  }
+
+  size_t start = 0;
+  tortoise = initial;
+  hare = advance(initial, step, length);
+  while (tortoise != hare) {
+    std::invoke(step, tortoise);
+    std::invoke(step, hare);
+    ++start;
+  }
+  return {.start = start, .length = length};
+}
+
+// Goes through the steps once, remembering the fingerprint of every state.
+// States with the same fingerprint are taken as equal, so it has to identify
+// them, or at least collide unlikely enough as a 64 bits hash does.
+template <std::copyable State, std::invocable<State &> Step,
+          std::invocable<const State &> Fingerprint>
+cycle_info find_cycle(const State &initial, Step step,
+                      Fingerprint fingerprint) {
+  using fingerprint_t =
+      std::decay_t<std::invoke_result_t<Fingerprint, const State &>>;
+  auto seen = flat_map<fingerprint_t, size_t>();
+  State state = initial;
+  for (size_t i = 0;; ++i) {
+    auto [it, inserted] =
+        seen.try_emplace(std::invoke(fingerprint, std::as_const(state)), i);
+    if (!inserted) {
+      return {.start = it->second, .length = i - it->second};
+    }
+    std::invoke(step, state);
+  }
+}
+
+} // namespace aoc
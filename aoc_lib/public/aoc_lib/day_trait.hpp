@@ -1,6 +1,7 @@
 #pragma once
 
 #include <aoc_lib/input.hpp>
+#include <aoc_lib/thread_pool.hpp>
 
 #include <chrono>
 #include <format>
@@ -96,6 +97,9 @@ template <day_trait Trait>
 void execute_day(const aoc::arguments &args,
                  std::output_iterator<const char &> auto out) {
   auto start = std::chrono::steady_clock::now();
+  // Parallel algorithms of the day share one pool of threads
+  thread_pool pool(args.threads.value_or(0));
+  thread_pool_scope pool_scope(pool);
   if (args.selected_part) {
     switch (*args.selected_part) {
     case part::one:
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// Set of the integers [0, size) packing one element per bit, value i being
+// bit i % 64 of word i / 64. Bits past size are always kept cleared, so that
+// whole word loops, which the compiler can vectorize, need no special case
+// for the last word.
+class dense_bitset {
+public:
+  using word_t = uint64_t;
+
+  static constexpr size_t word_bits = 64;
+
+  // Iterates over the elements of the set, in increasing order
+  class const_iterator {
+  public:
+    using value_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    const_iterator() = default;
+    explicit const_iterator(std::span<const word_t> words) : m_words(words) {
+      if (!m_words.empty()) {
+        m_word = m_words[0];
+        skip_empty_words();
+      }
+    }
+
+    size_t operator*() const {
+      return m_index * word_bits +
+             static_cast<size_t>(std::countr_zero(m_word));
+    }
+
+    const_iterator &operator++() {
+      // Clears the lowest set bit
+      m_word &= m_word - 1;
+      skip_empty_words();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==(std::default_sentinel_t) const {
+      return m_index == m_words.size();
+    }
+
+  private:
+    void skip_empty_words() {
+      while (m_word == 0 && ++m_index < m_words.size()) {
+        m_word = m_words[m_index];
+      }
+    }
+
+    std::span<const word_t> m_words;
+    size_t m_index = 0;
+    word_t m_word = 0;
+  };
+
+  dense_bitset() = default;
+
+  explicit dense_bitset(size_t size)
+      : m_size(size), m_words((size + word_bits - 1) / word_bits) {}
+
+  // Capacity of the set, not its number of elements
+  size_t size() const { return m_size; }
+
+  std::span<const word_t> words() const { return m_words; }
+
+  bool contains(size_t i) const {
+    return (m_words[i / word_bits] >> (i % word_bits)) & 1;
+  }
+
+  bool operator[](size_t i) const { return contains(i); }
+
+  // Returns false if i already was in the set
+  bool insert(size_t i) {
+    word_t &w = m_words[i / word_bits];
+    const word_t mask = word_t{1} << (i % word_bits);
+    const bool inserted = (w & mask) == 0;
+    w |= mask;
+    return inserted;
+  }
+
+  void erase(size_t i) {
+    m_words[i / word_bits] &= ~(word_t{1} << (i % word_bits));
+  }
+
+  void clear();
+
+  // Number of elements
+  size_t count() const;
+
+  bool any() const;
+  bool none() const { return !any(); }
+
+  // Whether both sets have an element in common
+  bool intersects(const dense_bitset &r) const;
+
+  const_iterator begin() const { return const_iterator(m_words); }
+  std::default_sentinel_t end() const { return {}; }
+
+  dense_bitset &operator&=(const dense_bitset &r);
+  dense_bitset &operator|=(const dense_bitset &r);
+  dense_bitset &operator^=(const dense_bitset &r);
+  // Difference
+  dense_bitset &operator-=(const dense_bitset &r);
+
+  friend dense_bitset operator&(dense_bitset l, const dense_bitset &r) {
+    return l &= r;
+  }
+  friend dense_bitset operator|(dense_bitset l, const dense_bitset &r) {
+    return l |= r;
+  }
+  friend dense_bitset operator^(dense_bitset l, const dense_bitset &r) {
+    return l ^= r;
+  }
+  friend dense_bitset operator-(dense_bitset l, const dense_bitset &r) {
+    return l -= r;
+  }
+
+  bool operator==(const dense_bitset &r) const = default;
+
+private:
+  size_t m_size = 0;
+  std::vector<word_t> m_words;
+};
+
+} // namespace aoc
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <aoc_lib/bucket_queue.hpp>
+#include <aoc_lib/flat_map.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace aoc {
+
+// Length of the shortest path from start to a state matching goal(state), or
+// nullopt if there is none. neighbours(state, visit) calls visit(next, weight)
+// for every state reachable in one move, with weights up to max_weight.
+template <typename State, typename Neighbours,
+          std::predicate<const State &> Goal>
+std::optional<size_t> dijkstra(const State &start, size_t max_weight,
+                               Neighbours neighbours, Goal goal) {
+  auto distances = flat_map<State, size_t>{{start, 0}};
+  auto to_visit = bucket_queue<State>(max_weight + 1);
+  to_visit.push(0, start);
+
+  while (!to_visit.empty()) {
+    auto [distance, cur] = to_visit.pop();
+    if (distance > distances.at(cur)) {
+      continue;
+    }
+    if (std::invoke(goal, cur)) {
+      return distance;
+    }
+    std::invoke(neighbours, cur, [&](const State &next, size_t weight) {
+      const size_t next_distance = distance + weight;
+      if (auto [it, inserted] = distances.try_emplace(next, next_distance);
+          inserted || next_distance < it->second) {
+        it->second = next_distance;
+        to_visit.push(next_distance, next);
+      }
+    });
+  }
+  return std::nullopt;
+}
+
+} // namespace aoc
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace aoc {
+
+// Partition of the elements [0, size) into disjoint components, merged with
+// union by size. Lookups halve the path to the representative of the
+// component, so that any sequence of operations runs in near linear time.
+class disjoint_set {
+public:
+  disjoint_set() = default;
+  explicit disjoint_set(size_t size);
+
+  // Number of elements
+  size_t size() const { return m_parents.size(); }
+
+  // Number of components
+  size_t components() const { return m_components; }
+
+  // Representative of the component of i
+  size_t find(size_t i);
+
+  bool same(size_t l, size_t r) { return find(l) == find(r); }
+
+  // Merges the components of l and r, returns false if they already were the
+  // same
+  bool unite(size_t l, size_t r);
+
+  size_t component_size(size_t i) { return m_sizes[find(i)]; }
+
+  // Sizes of the k largest components, largest first
+  std::vector<size_t> largest_components(size_t k) const;
+
+private:
+  std::vector<size_t> m_parents;
+  std::vector<size_t> m_sizes;
+  size_t m_components = 0;
+};
+
+} // namespace aoc
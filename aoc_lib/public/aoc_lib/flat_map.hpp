@@ -0,0 +1,98 @@
+#pragma once
+
+#include <aoc_lib/flat_table.hpp>
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace aoc {
+
+namespace detail {
+struct pair_first {
+  template <typename Pair> const auto &operator()(const Pair &p) const {
+    return p.first;
+  }
+};
+} // namespace detail
+
+// Drop-in replacement for std::unordered_map storing its elements inline in
+// a single array. Unlike std::unordered_map, any insertion may invalidate
+// references and iterators.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class flat_map
+    : public detail::flat_table<Key, std::pair<const Key, Value>,
+                                detail::pair_first, Hash, KeyEqual, false> {
+  using base = detail::flat_table<Key, std::pair<const Key, Value>,
+                                  detail::pair_first, Hash, KeyEqual, false>;
+
+public:
+  using mapped_type = Value;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::value_type;
+
+  flat_map() = default;
+
+  flat_map(std::initializer_list<value_type> init) {
+    this->reserve(init.size());
+    for (const value_type &v : init) {
+      insert(v);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return this->find_or_insert(key, [&](value_type *slot) {
+      std::construct_at(slot, std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return try_emplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return try_emplace(value.first, std::move(value.second));
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, V &&value) {
+    auto result = try_emplace(key, std::forward<V>(value));
+    if (!result.second) {
+      result.first->second = std::forward<V>(value);
+    }
+    return result;
+  }
+
+  Value &operator[](const Key &key) { return try_emplace(key).first->second; }
+
+  Value &at(const Key &key) {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      throw std::out_of_range("aoc::flat_map::at");
+    }
+    return found->second;
+  }
+
+  const Value &at(const Key &key) const {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      throw std::out_of_range("aoc::flat_map::at");
+    }
+    return found->second;
+  }
+};
+
+} // namespace aoc
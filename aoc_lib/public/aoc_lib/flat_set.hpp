@@ -0,0 +1,69 @@
+#pragma once
+
+#include <aoc_lib/flat_table.hpp>
+
+#include <functional>
+#include <initializer_list>
+#include <ranges>
+#include <utility>
+
+namespace aoc {
+
+namespace detail {
+struct identity_key {
+  template <typename Key> const Key &operator()(const Key &key) const {
+    return key;
+  }
+};
+} // namespace detail
+
+// Drop-in replacement for std::unordered_set storing its elements inline in
+// a single array. Unlike std::unordered_set, any insertion may invalidate
+// references and iterators.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class flat_set : public detail::flat_table<Key, Key, detail::identity_key,
+                                           Hash, KeyEqual, true> {
+  using base = detail::flat_table<Key, Key, detail::identity_key, Hash,
+                                  KeyEqual, true>;
+
+public:
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::value_type;
+
+  flat_set() = default;
+
+  flat_set(std::initializer_list<Key> init) {
+    this->reserve(init.size());
+    insert_range(init);
+  }
+
+  template <std::ranges::input_range R>
+  flat_set(std::from_range_t, R &&range) {
+    insert_range(std::forward<R>(range));
+  }
+
+  std::pair<iterator, bool> insert(const Key &key) {
+    return this->find_or_insert(
+        key, [&key](Key *slot) { std::construct_at(slot, key); });
+  }
+
+  std::pair<iterator, bool> insert(Key &&key) {
+    return this->find_or_insert(
+        key, [&key](Key *slot) { std::construct_at(slot, std::move(key)); });
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(Key(std::forward<Args>(args)...));
+  }
+
+  template <std::ranges::input_range R> void insert_range(R &&range) {
+    for (auto &&key : range) {
+      insert(std::forward<decltype(key)>(key));
+    }
+  }
+};
+
+} // namespace aoc
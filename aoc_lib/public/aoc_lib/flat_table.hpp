@@ -0,0 +1,389 @@
+#pragma once
+
+#include <aoc_lib/hash.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace aoc::detail {
+
+// Eight control bytes loaded in a single word, matched all at once with
+// word-wide bit tricks. A control byte is either empty, deleted, or holds the
+// 7 low bits of the hash of a full slot.
+class flat_group {
+public:
+  static constexpr size_t width = 8;
+  static constexpr uint8_t empty = 0x80;
+  static constexpr uint8_t deleted = 0xFE;
+
+  explicit flat_group(const uint8_t *ctrl) {
+    std::memcpy(&m_word, ctrl, sizeof(m_word));
+    if constexpr (std::endian::native == std::endian::big) {
+      m_word = std::byteswap(m_word);
+    }
+  }
+
+  // May report false positives on full slots, callers compare keys anyway
+  uint64_t match(uint8_t h2) const {
+    const uint64_t x = m_word ^ (lsbs * h2);
+    return (x - lsbs) & ~x & msbs;
+  }
+
+  uint64_t match_empty() const { return m_word & ~(m_word << 6) & msbs; }
+
+  uint64_t match_empty_or_deleted() const {
+    return m_word & ~(m_word << 7) & msbs;
+  }
+
+  static size_t lowest(uint64_t mask) { return std::countr_zero(mask) / 8; }
+
+private:
+  static constexpr uint64_t lsbs = 0x0101010101010101ull;
+  static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+  uint64_t m_word;
+};
+
+// Open addressing hash table storing its slots in a single array, probed by
+// groups of flat_group::width slots. Backs aoc::flat_map and aoc::flat_set.
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, bool ConstIteration>
+class flat_table {
+  template <bool Const> class basic_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Slot;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Slot *, Slot *>;
+    using reference = std::conditional_t<Const, const Slot &, Slot &>;
+
+    basic_iterator() = default;
+
+    template <bool OtherConst>
+    basic_iterator(const basic_iterator<OtherConst> &other)
+      requires(Const && !OtherConst)
+        : m_ctrl(other.m_ctrl), m_ctrl_end(other.m_ctrl_end),
+          m_slot(other.m_slot) {}
+
+    reference operator*() const { return *m_slot; }
+    pointer operator->() const { return m_slot; }
+
+    basic_iterator &operator++() {
+      ++m_ctrl;
+      ++m_slot;
+      skip_free();
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const basic_iterator &r) const {
+      return m_ctrl == r.m_ctrl;
+    }
+
+  private:
+    friend class flat_table;
+    template <bool> friend class basic_iterator;
+
+    basic_iterator(const uint8_t *ctrl, const uint8_t *ctrl_end, pointer slot)
+        : m_ctrl(ctrl), m_ctrl_end(ctrl_end), m_slot(slot) {}
+
+    void skip_free() {
+      while (m_ctrl != m_ctrl_end && (*m_ctrl & flat_group::empty) != 0) {
+        ++m_ctrl;
+        ++m_slot;
+      }
+    }
+
+    const uint8_t *m_ctrl = nullptr;
+    const uint8_t *m_ctrl_end = nullptr;
+    pointer m_slot = nullptr;
+  };
+
+public:
+  using key_type = Key;
+  using value_type = Slot;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using const_iterator = basic_iterator<true>;
+  using iterator = basic_iterator<ConstIteration>;
+
+  flat_table() = default;
+
+  flat_table(const flat_table &other)
+      : m_hash(other.m_hash), m_equal(other.m_equal) {
+    reserve(other.size());
+    for (const Slot &slot : other) {
+      const size_t hash = hash_of(KeyOf{}(slot));
+      const size_t i = find_free_slot(hash);
+      std::construct_at(m_slots + i, slot);
+      commit_insert(i, hash);
+    }
+  }
+
+  flat_table(flat_table &&other) noexcept
+      : m_slots(std::exchange(other.m_slots, nullptr)),
+        m_ctrl(std::exchange(other.m_ctrl, nullptr)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_growth_left(std::exchange(other.m_growth_left, 0)),
+        m_hash(std::move(other.m_hash)), m_equal(std::move(other.m_equal)) {}
+
+  flat_table &operator=(const flat_table &other) {
+    if (this != &other) {
+      *this = flat_table(other);
+    }
+    return *this;
+  }
+
+  flat_table &operator=(flat_table &&other) noexcept {
+    if (this != &other) {
+      release();
+      m_slots = std::exchange(other.m_slots, nullptr);
+      m_ctrl = std::exchange(other.m_ctrl, nullptr);
+      m_capacity = std::exchange(other.m_capacity, 0);
+      m_size = std::exchange(other.m_size, 0);
+      m_growth_left = std::exchange(other.m_growth_left, 0);
+      m_hash = std::move(other.m_hash);
+      m_equal = std::move(other.m_equal);
+    }
+    return *this;
+  }
+
+  ~flat_table() { release(); }
+
+  iterator begin() { return skipped(make_iterator(0)); }
+  iterator end() { return make_iterator(m_capacity); }
+  const_iterator begin() const { return skipped(make_const_iterator(0)); }
+  const_iterator end() const { return make_const_iterator(m_capacity); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  size_t capacity() const { return m_capacity; }
+
+  iterator find(const Key &key) {
+    const size_t i = find_index(key, hash_of(key));
+    return i == npos ? end() : make_iterator(i);
+  }
+
+  const_iterator find(const Key &key) const {
+    const size_t i = find_index(key, hash_of(key));
+    return i == npos ? end() : make_const_iterator(i);
+  }
+
+  bool contains(const Key &key) const {
+    return find_index(key, hash_of(key)) != npos;
+  }
+
+  size_t count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  size_t erase(const Key &key) {
+    const size_t i = find_index(key, hash_of(key));
+    if (i == npos) {
+      return 0;
+    }
+    erase_at(i);
+    return 1;
+  }
+
+  iterator erase(const_iterator it) {
+    const size_t i = static_cast<size_t>(it.m_ctrl - m_ctrl);
+    erase_at(i);
+    return skipped(make_iterator(i));
+  }
+
+  void clear() {
+    destroy_slots();
+    std::fill_n(m_ctrl, m_capacity, flat_group::empty);
+    m_size = 0;
+    m_growth_left = max_load(m_capacity);
+  }
+
+  void reserve(size_t count) {
+    size_t capacity = flat_group::width;
+    while (max_load(capacity) < count) {
+      capacity *= 2;
+    }
+    if (capacity > m_capacity) {
+      rehash(capacity);
+    }
+  }
+
+protected:
+  // Finds the slot of `key`, or constructs a new one with
+  // `construct(Slot *)`.
+  template <typename Construct>
+  std::pair<iterator, bool> find_or_insert(const Key &key,
+                                           Construct &&construct) {
+    const size_t hash = hash_of(key);
+    if (const size_t found = find_index(key, hash); found != npos) {
+      return {make_iterator(found), false};
+    }
+    if (m_growth_left == 0) {
+      grow();
+    }
+    const size_t i = find_free_slot(hash);
+    std::forward<Construct>(construct)(m_slots + i);
+    commit_insert(i, hash);
+    return {make_iterator(i), true};
+  }
+
+private:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  // Keeps at least one empty slot in every eight, so probing always ends
+  static constexpr size_t max_load(size_t capacity) {
+    return capacity - capacity / 8;
+  }
+
+  // The user hash is mixed again as std::hash is the identity for integers,
+  // while probing relies on both the low and the high bits.
+  size_t hash_of(const Key &key) const { return hash_mix(m_hash(key), 0); }
+
+  static uint8_t h2(size_t hash) { return static_cast<uint8_t>(hash & 0x7F); }
+
+  size_t first_group(size_t hash) const {
+    return (hash >> 7) & (m_capacity / flat_group::width - 1);
+  }
+
+  // Triangular probing visits every group when their count is a power of two
+  size_t next_group(size_t group, size_t step) const {
+    return (group + step) & (m_capacity / flat_group::width - 1);
+  }
+
+  size_t find_index(const Key &key, size_t hash) const {
+    if (m_capacity == 0) {
+      return npos;
+    }
+    size_t group = first_group(hash);
+    for (size_t step = 1;; ++step) {
+      const auto ctrl = flat_group(m_ctrl + group * flat_group::width);
+      for (uint64_t m = ctrl.match(h2(hash)); m != 0; m &= m - 1) {
+        const size_t i = group * flat_group::width + flat_group::lowest(m);
+        if (m_equal(KeyOf{}(m_slots[i]), key)) {
+          return i;
+        }
+      }
+      if (ctrl.match_empty() != 0) {
+        return npos;
+      }
+      group = next_group(group, step);
+    }
+  }
+
+  size_t find_free_slot(size_t hash) const {
+    size_t group = first_group(hash);
+    for (size_t step = 1;; ++step) {
+      const auto ctrl = flat_group(m_ctrl + group * flat_group::width);
+      if (const uint64_t m = ctrl.match_empty_or_deleted(); m != 0) {
+        return group * flat_group::width + flat_group::lowest(m);
+      }
+      group = next_group(group, step);
+    }
+  }
+
+  void commit_insert(size_t i, size_t hash) {
+    if (m_ctrl[i] == flat_group::empty) {
+      --m_growth_left;
+    }
+    m_ctrl[i] = h2(hash);
+    ++m_size;
+  }
+
+  void erase_at(size_t i) {
+    std::destroy_at(m_slots + i);
+    m_ctrl[i] = flat_group::deleted;
+    --m_size;
+  }
+
+  void grow() {
+    if (m_capacity > 0 && m_size <= max_load(m_capacity) / 2) {
+      // Mostly tombstones, clean them up in place
+      rehash(m_capacity);
+    } else {
+      rehash(std::max(m_capacity * 2, flat_group::width));
+    }
+  }
+
+  void rehash(size_t capacity) {
+    auto *slots = std::allocator<Slot>{}.allocate(capacity);
+    auto *ctrl = new uint8_t[capacity];
+    std::fill_n(ctrl, capacity, flat_group::empty);
+
+    auto *old_slots = std::exchange(m_slots, slots);
+    auto *old_ctrl = std::exchange(m_ctrl, ctrl);
+    const size_t old_capacity = std::exchange(m_capacity, capacity);
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if ((old_ctrl[i] & flat_group::empty) == 0) {
+        const size_t hash = hash_of(KeyOf{}(old_slots[i]));
+        const size_t target = find_free_slot(hash);
+        std::construct_at(m_slots + target, std::move(old_slots[i]));
+        std::destroy_at(old_slots + i);
+        m_ctrl[target] = h2(hash);
+      }
+    }
+    m_growth_left = max_load(m_capacity) - m_size;
+
+    if (old_slots != nullptr) {
+      std::allocator<Slot>{}.deallocate(old_slots, old_capacity);
+    }
+    delete[] old_ctrl;
+  }
+
+  void destroy_slots() {
+    if constexpr (!std::is_trivially_destructible_v<Slot>) {
+      for (size_t i = 0; i < m_capacity; ++i) {
+        if ((m_ctrl[i] & flat_group::empty) == 0) {
+          std::destroy_at(m_slots + i);
+        }
+      }
+    }
+  }
+
+  void release() {
+    if (m_slots != nullptr) {
+      destroy_slots();
+      std::allocator<Slot>{}.deallocate(m_slots, m_capacity);
+    }
+    delete[] m_ctrl;
+    m_slots = nullptr;
+    m_ctrl = nullptr;
+    m_capacity = m_size = m_growth_left = 0;
+  }
+
+  iterator make_iterator(size_t i) {
+    return iterator(m_ctrl + i, m_ctrl + m_capacity, m_slots + i);
+  }
+
+  const_iterator make_const_iterator(size_t i) const {
+    return const_iterator(m_ctrl + i, m_ctrl + m_capacity, m_slots + i);
+  }
+
+  template <typename It> static It skipped(It it) {
+    it.skip_free();
+    return it;
+  }
+
+  Slot *m_slots = nullptr;
+  uint8_t *m_ctrl = nullptr;
+  size_t m_capacity = 0;
+  size_t m_size = 0;
+  size_t m_growth_left = 0;
+  Hash m_hash;
+  KeyEqual m_equal;
+};
+
+} // namespace aoc::detail
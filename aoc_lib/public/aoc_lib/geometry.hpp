@@ -1,8 +1,20 @@
 #pragma once
 
 #include <aoc_lib/geometry/algorithm.hpp>
+#include <aoc_lib/geometry/bit_matrix.hpp>
+#include <aoc_lib/geometry/box.hpp>
 #include <aoc_lib/geometry/dimensions.hpp>
 #include <aoc_lib/geometry/dyn_matrix.hpp>
 #include <aoc_lib/geometry/fixed_matrix.hpp>
+#include <aoc_lib/geometry/grid_input.hpp>
+#include <aoc_lib/geometry/grid_search.hpp>
+#include <aoc_lib/geometry/kd_tree.hpp>
+#include <aoc_lib/geometry/manhattan_ball_index.hpp>
+#include <aoc_lib/geometry/metric.hpp>
+#include <aoc_lib/geometry/padded_matrix.hpp>
 #include <aoc_lib/geometry/point.hpp>
+#include <aoc_lib/geometry/point_array.hpp>
+#include <aoc_lib/geometry/prefix_sum_2d.hpp>
+#include <aoc_lib/geometry/sparse_grid.hpp>
+#include <aoc_lib/geometry/stencil.hpp>
 #include <aoc_lib/geometry/vector.hpp>
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <aoc_lib/geometry/point.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// Boolean matrix packing one cell per bit. Each row is padded to a whole
+// number of 64 bits words, column n of a row being bit n % 64 of its word
+// n / 64. Padding bits are always kept cleared.
+class bit_matrix {
+public:
+  using point_t = point2d<size_t>;
+  using word_t = uint64_t;
+
+  static constexpr size_t word_bits = 64;
+
+  bit_matrix() = default;
+
+  bit_matrix(size_t width, size_t height)
+      : m_width(width), m_height(height),
+        m_words_per_row((width + word_bits - 1) / word_bits),
+        m_words(m_words_per_row * height) {}
+
+  size_t width() const { return m_width; }
+  size_t height() const { return m_height; }
+  size_t words_per_row() const { return m_words_per_row; }
+
+  bool contains(size_t m, size_t n) const {
+    return n < width() && m < height();
+  }
+
+  bool contains(const point_t &p) const { return contains(p.y(), p.x()); }
+
+  bool at(size_t m, size_t n) const {
+    return (word(m, n) >> (n % word_bits)) & 1;
+  }
+
+  bool at(const point_t &p) const { return at(p.y(), p.x()); }
+
+  bool operator[](size_t m, size_t n) const { return at(m, n); }
+  bool operator[](const point_t &p) const { return at(p); }
+
+  void set(size_t m, size_t n, bool value = true) {
+    const word_t mask = word_t{1} << (n % word_bits);
+    word_t &w = word(m, n);
+    w = value ? w | mask : w & ~mask;
+  }
+
+  void set(const point_t &p, bool value = true) { set(p.y(), p.x(), value); }
+
+  void flip(size_t m, size_t n) { word(m, n) ^= word_t{1} << (n % word_bits); }
+
+  std::span<word_t> row(size_t m) {
+    return std::span(m_words).subspan(m * m_words_per_row, m_words_per_row);
+  }
+
+  std::span<const word_t> row(size_t m) const {
+    return std::span(m_words).subspan(m * m_words_per_row, m_words_per_row);
+  }
+
+  // Number of set cells
+  size_t count() const;
+
+  bool any() const;
+  bool none() const { return !any(); }
+
+  // Returns a copy where the cell (m, n) moved to (m + dm, n + dn); the cells
+  // moving out of the matrix are dropped.
+  bit_matrix shifted(ptrdiff_t dm, ptrdiff_t dn) const;
+
+  // Whether any cell is set in both matrices
+  bool intersects(const bit_matrix &r) const;
+
+  bit_matrix &operator&=(const bit_matrix &r);
+  bit_matrix &operator|=(const bit_matrix &r);
+  bit_matrix &operator^=(const bit_matrix &r);
+
+  friend bit_matrix operator&(bit_matrix l, const bit_matrix &r) {
+    return l &= r;
+  }
+  friend bit_matrix operator|(bit_matrix l, const bit_matrix &r) {
+    return l |= r;
+  }
+  friend bit_matrix operator^(bit_matrix l, const bit_matrix &r) {
+    return l ^= r;
+  }
+
+  // Complement within the matrix bounds
+  bit_matrix operator~() const;
+
+  bool operator==(const bit_matrix &r) const = default;
+
+private:
+  word_t &word(size_t m, size_t n) {
+    return m_words[m * m_words_per_row + n / word_bits];
+  }
+
+  const word_t &word(size_t m, size_t n) const {
+    return m_words[m * m_words_per_row + n / word_bits];
+  }
+
+  // Mask of the valid bits of the last word of each row
+  word_t last_word_mask() const;
+
+  size_t m_width = 0;
+  size_t m_height = 0;
+  size_t m_words_per_row = 0;
+  std::vector<word_t> m_words;
+};
+
+} // namespace aoc
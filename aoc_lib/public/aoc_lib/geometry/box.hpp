@@ -0,0 +1,43 @@
+#pragma once
+
+#include <aoc_lib/geometry/point.hpp>
+
+#include <algorithm>
+
+namespace aoc {
+
+// Axis aligned box, both corners included
+template <scalar S, size_t M> struct box {
+  point<S, M> min;
+  point<S, M> max;
+
+  constexpr bool contains(const point<S, M> &p) const {
+    for (size_t i = 0; i < M; ++i) {
+      if (p[i] < min[i] || p[i] > max[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr bool intersects(const box &r) const {
+    for (size_t i = 0; i < M; ++i) {
+      if (r.max[i] < min[i] || r.min[i] > max[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Grows the box to also cover r
+  constexpr void extend(const box &r) {
+    for (size_t i = 0; i < M; ++i) {
+      min[i] = std::min(min[i], r.min[i]);
+      max[i] = std::max(max[i], r.max[i]);
+    }
+  }
+
+  constexpr bool operator==(const box &) const = default;
+};
+
+} // namespace aoc
@@ -4,6 +4,7 @@
 
 #include <cassert>
 #include <ranges>
+#include <span>
 #include <vector>
 
 namespace aoc {
@@ -71,6 +72,16 @@ public:
     return std::forward<Self>(self).at(p.y(), p.x());
   }
 
+  template <typename Self>
+  constexpr auto row(this Self &&self, size_t m) {
+    return std::span(self.m_data).subspan(m * self.m_width, self.m_width);
+  }
+
+  std::ranges::view auto rows() const {
+    return std::views::iota(size_t{}, height()) |
+           std::views::transform([this](size_t m) { return row(m); });
+  }
+
   size_t width() const { return m_width; }
   size_t height() const { return m_width > 0 ? m_data.size() / width() : 0; }
 
@@ -6,7 +6,11 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <ranges>
+#include <utility>
 
 namespace aoc {
 template <scalar T, std::size_t M, std::size_t N> class fixed_matrix {
@@ -39,10 +43,10 @@ public:
   template <typename F>
   constexpr auto transform(F &&func) const
       -> fixed_matrix<std::invoke_result_t<F, const T &>, M, N> {
-    using U = std::invoke_result_t<F, const T &>;
-    typename fixed_matrix<U, M, N>::array_type result;
-    std::ranges::transform(m_data, result.begin(), std::forward<F>(func));
-    return fixed_matrix<U, M, N>(std::move(result));
+    using Res = fixed_matrix<std::invoke_result_t<F, const T &>, M, N>;
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return Res(typename Res::array_type{func(m_data[I])...});
+    }(std::make_index_sequence<M * N>{});
   }
 
   template <scalar U>
@@ -90,46 +94,30 @@ public:
   template <scalar U>
   friend constexpr auto operator+(const fixed_matrix &l,
                                   const fixed_matrix<U, M, N> &r) {
-    auto range = std::views::zip(l.data(), r.data()) |
-                 std::views::transform([]<typename Tuple>(Tuple &&t) {
-                   return std::get<0>(std::forward<Tuple>(t)) +
-                          std::get<1>(std::forward<Tuple>(t));
-                 });
-    return fixed_matrix<std::ranges::range_value_t<decltype(range)>, M, N>(
-        std::from_range, std::move(range));
+    return zip_transform(l, r, std::plus<>{});
   }
 
   template <scalar U>
   friend constexpr auto operator-(const fixed_matrix &l,
                                   const fixed_matrix<U, M, N> &r) {
-    auto range = std::views::zip(l.data(), r.data()) |
-                 std::views::transform([]<typename Tuple>(Tuple &&t) {
-                   return std::get<0>(std::forward<Tuple>(t)) -
-                          std::get<1>(std::forward<Tuple>(t));
-                 });
-    return fixed_matrix<std::ranges::range_value_t<decltype(range)>, M, N>(
-        std::from_range, std::move(range));
+    return zip_transform(l, r, std::minus<>{});
   }
 
   template <scalar U>
-  friend constexpr fixed_matrix operator+=(fixed_matrix &l,
-                                           const fixed_matrix<U, M, N> &r) {
-    for (size_t m = 0; m < M; ++m) {
-      for (size_t n = 0; n < N; ++n) {
-        l.at(m, n) += r.at(m, n);
-      }
-    }
+  friend constexpr fixed_matrix &operator+=(fixed_matrix &l,
+                                            const fixed_matrix<U, M, N> &r) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((l.m_data[I] += r.at(I / N, I % N)), ...);
+    }(std::make_index_sequence<M * N>{});
     return l;
   }
 
   template <scalar U>
-  friend constexpr fixed_matrix operator-=(fixed_matrix &l,
-                                           const fixed_matrix<U, M, N> &r) {
-    for (size_t m = 0; m < M; ++m) {
-      for (size_t n = 0; n < N; ++n) {
-        l.at(m, n) -= r.at(m, n);
-      }
-    }
+  friend constexpr fixed_matrix &operator-=(fixed_matrix &l,
+                                            const fixed_matrix<U, M, N> &r) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((l.m_data[I] -= r.at(I / N, I % N)), ...);
+    }(std::make_index_sequence<M * N>{});
     return l;
   }
 
@@ -138,20 +126,33 @@ public:
                                   const fixed_matrix<U, N, P> &r) {
     using MulRes = decltype(std::declval<T>() * std::declval<U>());
     using Res = decltype(std::declval<MulRes>() + std::declval<MulRes>());
-    fixed_matrix<Res, M, P> result{};
+    using Result = fixed_matrix<Res, M, P>;
 
-    for (size_t i = 0; i < M; ++i) {
-      for (size_t j = 0; j < P; ++j) {
-        for (size_t k = 0; k < N; ++k) {
-          result.at(i, j) += l.at(i, k) * r.at(k, j);
-        }
-      }
-    }
-
-    return result;
+    auto dot = [&]<size_t... K>(size_t i, size_t j, std::index_sequence<K...>) {
+      return static_cast<Res>((Res{} + ... + (l.at(i, K) * r.at(K, j))));
+    };
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return Result(typename Result::array_type{
+          dot(I / P, I % P, std::make_index_sequence<N>{})...});
+    }(std::make_index_sequence<M * P>{});
   }
 
 private:
+  // The element-wise operations are expanded over an index sequence rather
+  // than looped over: for the small shapes used by points and vectors, this
+  // gives straight line code that the compiler turns into SIMD operations.
+  template <scalar U, typename F>
+  static constexpr auto zip_transform(const fixed_matrix &l,
+                                      const fixed_matrix<U, M, N> &r,
+                                      F &&func) {
+    using Res =
+        fixed_matrix<std::invoke_result_t<F &, const T &, const U &>, M, N>;
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return Res(
+          typename Res::array_type{func(l.m_data[I], r.at(I / N, I % N))...});
+    }(std::make_index_sequence<M * N>{});
+  }
+
   array_type m_data;
 };
 
@@ -180,15 +181,24 @@ struct dimensions<T> : dimensions<typename T::matrix_type> {};
 template <typename T, std::size_t M, std::size_t N>
 struct std::hash<fixed_matrix<T, M, N>> {
   size_t operator()(const aoc::fixed_matrix<T, M, N> &p) const noexcept {
-    std::hash<T> hasher;
-    aoc::hash_accumulator acc;
-
-    for (size_t m = 0; m < M; ++m) {
-      for (size_t n = 0; n < N; ++n) {
-        acc.accumulate(hasher(p.at(m, n)));
+    if constexpr (std::is_integral_v<T> &&
+                  sizeof(T) * M * N <= 2 * sizeof(uint64_t)) {
+      // Small integral matrices, like most points, fit in two words and are
+      // hashed from their bytes with a single mixing step.
+      uint64_t words[2] = {};
+      std::memcpy(words, &p.at(0, 0), sizeof(T) * M * N);
+      return aoc::hash_mix(words[0], words[1]);
+    } else {
+      std::hash<T> hasher;
+      aoc::hash_accumulator acc;
+
+      for (size_t m = 0; m < M; ++m) {
+        for (size_t n = 0; n < N; ++n) {
+          acc.accumulate(hasher(p.at(m, n)));
+        }
       }
+      return acc.result();
     }
-    return acc.result();
   }
 };
 
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <aoc_lib/geometry/dyn_matrix.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace aoc {
+
+// Maps each character of a grid to a compact cell code: the index of the
+// character in the alphabet.
+class grid_alphabet {
+public:
+  static constexpr uint8_t invalid = 0xFF;
+
+  constexpr grid_alphabet(std::string_view symbols) : m_symbols(symbols) {
+    m_codes.fill(invalid);
+    for (size_t i = 0; i < symbols.size() && i < invalid; ++i) {
+      m_codes[static_cast<unsigned char>(symbols[i])] = static_cast<uint8_t>(i);
+    }
+  }
+
+  constexpr uint8_t code(char c) const {
+    return m_codes[static_cast<unsigned char>(c)];
+  }
+
+  constexpr char symbol(uint8_t code) const { return m_symbols[code]; }
+
+  constexpr size_t size() const { return m_symbols.size(); }
+
+private:
+  std::string_view m_symbols;
+  std::array<uint8_t, 256> m_codes{};
+};
+
+// Parses a rectangular grid of decimal digits into their values. Throws on
+// ragged rows or non digit characters.
+dyn_matrix<uint8_t> digit_grid(std::string_view input);
+
+// Parses a rectangular grid of characters into the codes of the given
+// alphabet. Throws on ragged rows or characters outside of the alphabet.
+dyn_matrix<uint8_t> char_grid(std::string_view input,
+                              const grid_alphabet &alphabet);
+
+} // namespace aoc
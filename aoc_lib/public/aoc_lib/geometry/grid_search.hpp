@@ -0,0 +1,222 @@
+#pragma once
+
+#include <aoc_lib/geometry/point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Order in which a grid search looks at the neighbours of a cell, as {dm, dn}
+// steps, and whether cells at the same distance from the start are expanded
+// in reading order rather than in the order they were found.
+template <size_t N> struct neighbour_order {
+  std::array<std::array<ptrdiff_t, 2>, N> steps;
+  bool sorted_layers;
+};
+
+namespace neighbour_orders {
+// Up, left, right, down, one layer after the other in reading order
+inline constexpr neighbour_order<4> reading{
+    {{{-1, 0}, {0, -1}, {0, 1}, {1, 0}}}, true};
+
+inline constexpr neighbour_order<4> manhattan{
+    {{{-1, 0}, {0, -1}, {0, 1}, {1, 0}}}, false};
+
+inline constexpr neighbour_order<8> euclidean{
+    {{{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}},
+    false};
+} // namespace neighbour_orders
+
+// Breadth first, Dijkstra and A* searches over the cells of a width x height
+// grid. Distances and parents are kept in flat arrays indexed like a
+// dyn_matrix, which every search reuses: an entry only belongs to the current
+// search when its generation matches, so that starting a search does not need
+// to clear them.
+template <typename D = uint32_t> class grid_search {
+public:
+  using point_t = point2d<size_t>;
+  using distance_t = D;
+
+  grid_search(size_t width, size_t height)
+      : m_width(width), m_height(height), m_generations(width * height),
+        m_distances(width * height), m_parents(width * height) {}
+
+  size_t width() const { return m_width; }
+  size_t height() const { return m_height; }
+
+  // Whether the last search reached p
+  bool reached(const point_t &p) const { return reached(index(p)); }
+
+  // Distance from the start of the last search to p, once reached
+  D distance(const point_t &p) const { return m_distances[index(p)]; }
+
+  // Cell from which the last search reached p, the start being its own parent
+  point_t parent(const point_t &p) const {
+    return position(m_parents[index(p)]);
+  }
+
+  // Cells from the start of the last search to p, both included
+  std::vector<point_t> path(const point_t &p) const {
+    std::vector<point_t> res{p};
+    for (size_t i = index(p); m_parents[i] != i; i = m_parents[i]) {
+      res.push_back(position(m_parents[i]));
+    }
+    std::ranges::reverse(res);
+    return res;
+  }
+
+  // Reaches the cells for which passable(p) holds, closest first. Each
+  // neighbour looked at is first checked with goal(p), and the first one
+  // matching is returned, its parent being the cell being expanded. Any cell
+  // keeps as parent the first cell that reached it.
+  template <std::predicate<const point_t &> Passable,
+            std::predicate<const point_t &> Goal, size_t N = 4>
+  std::optional<point_t>
+  bfs(const point_t &start, Passable passable, Goal goal,
+      const neighbour_order<N> &order = neighbour_orders::manhattan) {
+    start_search(index(start));
+    m_layer.assign({index(start)});
+    for (D distance = 1; !m_layer.empty(); ++distance) {
+      m_next.clear();
+      for (size_t cur : m_layer) {
+        for (const auto &step : order.steps) {
+          const auto next = neighbour(cur, step);
+          if (!next) {
+            continue;
+          }
+          const point_t p = position(*next);
+          if (std::invoke(goal, p)) {
+            if (!reached(*next)) {
+              reach(*next, distance, cur);
+            }
+            return p;
+          }
+          if (!reached(*next) && std::invoke(passable, p)) {
+            reach(*next, distance, cur);
+            m_next.push_back(*next);
+          }
+        }
+      }
+      if (order.sorted_layers) {
+        std::ranges::sort(m_next);
+      }
+      std::swap(m_layer, m_next);
+    }
+    return std::nullopt;
+  }
+
+  // cost(from, to) gives the cost of moving between two adjacent cells, or
+  // nullopt if it is not possible. Returns the first cell matching goal(p)
+  // once its distance is known.
+  template <typename Cost, std::predicate<const point_t &> Goal, size_t N = 4>
+    requires std::is_invocable_r_v<std::optional<D>, Cost, const point_t &,
+                                   const point_t &>
+  std::optional<point_t>
+  dijkstra(const point_t &start, Cost cost, Goal goal,
+           const neighbour_order<N> &order = neighbour_orders::manhattan) {
+    return a_star(
+        start, std::move(cost), std::move(goal),
+        [](const point_t &) { return D{}; }, order);
+  }
+
+  // Same as dijkstra, with heuristic(p) a lower bound of the distance from p
+  // to the closest goal.
+  template <typename Cost, std::predicate<const point_t &> Goal,
+            typename Heuristic, size_t N = 4>
+    requires std::is_invocable_r_v<std::optional<D>, Cost, const point_t &,
+                                   const point_t &> &&
+             std::is_invocable_r_v<D, Heuristic, const point_t &>
+  std::optional<point_t>
+  a_star(const point_t &start, Cost cost, Goal goal, Heuristic heuristic,
+         const neighbour_order<N> &order = neighbour_orders::manhattan) {
+    start_search(index(start));
+    m_heap.clear();
+    m_heap.emplace_back(std::invoke(heuristic, start), index(start));
+    while (!m_heap.empty()) {
+      std::ranges::pop_heap(m_heap, std::greater{});
+      const auto [estimate, cur] = m_heap.back();
+      m_heap.pop_back();
+      const point_t p = position(cur);
+      if (estimate - std::invoke(heuristic, p) > m_distances[cur]) {
+        continue;
+      }
+      if (std::invoke(goal, p)) {
+        return p;
+      }
+      for (const auto &step : order.steps) {
+        const auto next = neighbour(cur, step);
+        if (!next) {
+          continue;
+        }
+        const point_t q = position(*next);
+        const std::optional<D> move = std::invoke(cost, p, q);
+        if (!move) {
+          continue;
+        }
+        const D distance = m_distances[cur] + *move;
+        if (!reached(*next) || distance < m_distances[*next]) {
+          reach(*next, distance, cur);
+          m_heap.emplace_back(distance + std::invoke(heuristic, q), *next);
+          std::ranges::push_heap(m_heap, std::greater{});
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
+private:
+  size_t index(const point_t &p) const { return p.y() * m_width + p.x(); }
+
+  point_t position(size_t index) const {
+    return {index % m_width, index / m_width};
+  }
+
+  bool reached(size_t index) const {
+    return m_generations[index] == m_generation;
+  }
+
+  void reach(size_t index, D distance, size_t parent) {
+    m_generations[index] = m_generation;
+    m_distances[index] = distance;
+    m_parents[index] = parent;
+  }
+
+  void start_search(size_t start) {
+    if (++m_generation == 0) {
+      std::ranges::fill(m_generations, 0);
+      m_generation = 1;
+    }
+    reach(start, D{}, start);
+  }
+
+  std::optional<size_t> neighbour(size_t index,
+                                  const std::array<ptrdiff_t, 2> &step) const {
+    const size_t m = index / m_width + static_cast<size_t>(step[0]);
+    const size_t n = index % m_width + static_cast<size_t>(step[1]);
+    if (m >= m_height || n >= m_width) {
+      return std::nullopt;
+    }
+    return m * m_width + n;
+  }
+
+  size_t m_width;
+  size_t m_height;
+  uint32_t m_generation = 0;
+  std::vector<uint32_t> m_generations;
+  std::vector<D> m_distances;
+  std::vector<size_t> m_parents;
+  std::vector<size_t> m_layer;
+  std::vector<size_t> m_next;
+  std::vector<std::pair<D, size_t>> m_heap;
+};
+
+} // namespace aoc
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <aoc_lib/geometry/metric.hpp>
+#include <aoc_lib/geometry/point.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Static spatial index over a set of points. Points are referred to by their
+// index in the range the tree was built from.
+//
+// The tree is implicit: each node is a range of the permuted indices, split at
+// its middle element along the axis where the range is the most spread out.
+template <scalar S, size_t M> class kd_tree {
+public:
+  using point_t = point<S, M>;
+  // Index of a point and its distance to the query point
+  using neighbour_t = std::pair<size_t, S>;
+
+  kd_tree() = default;
+
+  template <std::ranges::input_range R>
+  kd_tree(std::from_range_t from_range, R &&points)
+      : m_points(from_range, std::forward<R>(points)),
+        m_order(m_points.size()), m_axis(m_points.size()) {
+    std::iota(m_order.begin(), m_order.end(), size_t{});
+    build(0, m_points.size());
+  }
+
+  size_t size() const { return m_points.size(); }
+  bool empty() const { return m_points.empty(); }
+
+  const point_t &operator[](size_t i) const { return m_points[i]; }
+
+  // The k closest points, sorted by distance then index
+  template <distance_metric Metric>
+  std::vector<neighbour_t> nearest(const point_t &from, size_t k,
+                                   Metric metric) const {
+    std::vector<neighbour_t> heap;
+    if (k == 0) {
+      return heap;
+    }
+    heap.reserve(std::min(k, size()) + 1);
+    search_nearest(0, size(), from, k, metric, heap);
+    std::ranges::sort_heap(heap, by_distance);
+    return heap;
+  }
+
+  // The closest point, or nullopt if there are several points at the closest
+  // distance.
+  template <distance_metric Metric>
+  std::optional<size_t> unique_nearest(const point_t &from,
+                                       Metric metric) const {
+    auto closest = nearest(from, 2, metric);
+    if (closest.empty() ||
+        (closest.size() == 2 && closest[0].second == closest[1].second)) {
+      return std::nullopt;
+    }
+    return closest[0].first;
+  }
+
+  // Indices of the points at a distance of at most `radius`, in no particular
+  // order.
+  template <distance_metric Metric>
+  std::vector<size_t> within(const point_t &from, S radius,
+                             Metric metric) const {
+    std::vector<size_t> res;
+    search_within(0, size(), from, radius, metric, res);
+    return res;
+  }
+
+private:
+  static bool by_distance(const neighbour_t &l, const neighbour_t &r) {
+    return l.second < r.second || (l.second == r.second && l.first < r.first);
+  }
+
+  void build(size_t lo, size_t hi) {
+    if (hi - lo <= 1) {
+      return;
+    }
+    uint8_t axis = 0;
+    S widest{};
+    for (size_t d = 0; d < M; ++d) {
+      auto [min, max] = std::ranges::minmax(
+          std::ranges::subrange(m_order.begin() + lo, m_order.begin() + hi),
+          {}, [this, d](size_t i) { return m_points[i][d]; });
+      if (S spread = m_points[max][d] - m_points[min][d]; spread > widest) {
+        widest = spread;
+        axis = static_cast<uint8_t>(d);
+      }
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    std::ranges::nth_element(
+        m_order.begin() + lo, m_order.begin() + mid, m_order.begin() + hi, {},
+        [this, axis](size_t i) { return m_points[i][axis]; });
+    m_axis[mid] = axis;
+    build(lo, mid);
+    build(mid + 1, hi);
+  }
+
+  template <distance_metric Metric>
+  void search_nearest(size_t lo, size_t hi, const point_t &from, size_t k,
+                      Metric metric, std::vector<neighbour_t> &heap) const {
+    if (lo >= hi) {
+      return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    const size_t i = m_order[mid];
+    const auto candidate = neighbour_t{i, distance(metric, from, m_points[i])};
+    if (heap.size() < k) {
+      heap.push_back(candidate);
+      std::ranges::push_heap(heap, by_distance);
+    } else if (by_distance(candidate, heap.front())) {
+      std::ranges::pop_heap(heap, by_distance);
+      heap.back() = candidate;
+      std::ranges::push_heap(heap, by_distance);
+    }
+
+    const uint8_t axis = m_axis[mid];
+    const S split = m_points[i][axis];
+    const bool lower_first = from[axis] < split;
+    search_nearest(lower_first ? lo : mid + 1, lower_first ? mid : hi, from, k,
+                   metric, heap);
+    // Points at the same distance as the worst one may still win on index
+    if (heap.size() < k || metric::distance_term(metric, from[axis], split) <=
+                               heap.front().second) {
+      search_nearest(lower_first ? mid + 1 : lo, lower_first ? hi : mid, from,
+                     k, metric, heap);
+    }
+  }
+
+  template <distance_metric Metric>
+  void search_within(size_t lo, size_t hi, const point_t &from, S radius,
+                     Metric metric, std::vector<size_t> &res) const {
+    if (lo >= hi) {
+      return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    const size_t i = m_order[mid];
+    if (distance(metric, from, m_points[i]) <= radius) {
+      res.push_back(i);
+    }
+
+    const uint8_t axis = m_axis[mid];
+    const S split = m_points[i][axis];
+    const bool reaches_plane =
+        metric::distance_term(metric, from[axis], split) <= radius;
+    if (from[axis] <= split || reaches_plane) {
+      search_within(lo, mid, from, radius, metric, res);
+    }
+    if (from[axis] >= split || reaches_plane) {
+      search_within(mid + 1, hi, from, radius, metric, res);
+    }
+  }
+
+  std::vector<point_t> m_points;
+  std::vector<size_t> m_order;
+  std::vector<uint8_t> m_axis;
+};
+
+template <std::ranges::input_range R>
+kd_tree(std::from_range_t, R &&)
+    -> kd_tree<typename std::ranges::range_value_t<R>::value_type,
+               dimensions<std::ranges::range_value_t<R>>::M()>;
+
+} // namespace aoc
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <aoc_lib/geometry/box.hpp>
+#include <aoc_lib/geometry/point.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+namespace aoc {
+
+// Points at a Manhattan distance of at most `radius` from `center`
+template <scalar S, size_t M> struct manhattan_ball {
+  point<S, M> center;
+  S radius;
+};
+
+// Index over a set of Manhattan balls answering how many of them cover a point
+// or intersect a box.
+//
+// In the rotated coordinates u_s(x) = x0 +/- x1 +/- ... +/- xM-1, one per sign
+// combination, a Manhattan ball is exactly the axis aligned box of half size
+// radius around its rotated center. The balls are grouped in a bounding volume
+// hierarchy keeping both those rotated bounds and the bounds of the centers,
+// so that whole subtrees get discarded, or counted at once when every one of
+// their balls is known to intersect the query.
+template <scalar S, size_t M> class manhattan_ball_index {
+public:
+  using point_t = point<S, M>;
+  using box_t = box<S, M>;
+  using ball_t = manhattan_ball<S, M>;
+
+  manhattan_ball_index() = default;
+
+  template <std::ranges::input_range R>
+  manhattan_ball_index(std::from_range_t from_range, R &&balls)
+      : m_balls(from_range, std::forward<R>(balls)) {
+    if (!m_balls.empty()) {
+      m_nodes.emplace_back();
+      build(0, 0, m_balls.size());
+    }
+  }
+
+  size_t size() const { return m_balls.size(); }
+
+  size_t count_covering(const point_t &p) const {
+    return count_intersecting(box_t{p, p});
+  }
+
+  size_t count_intersecting(const box_t &b) const {
+    if (m_nodes.empty()) {
+      return 0;
+    }
+    return count_intersecting(0, b, rotate(b));
+  }
+
+private:
+  static constexpr size_t K = size_t{1} << (M - 1);
+  static constexpr size_t leaf_size = 8;
+
+  using rotated_box_t = box<S, K>;
+
+  struct node_t {
+    rotated_box_t rotated;
+    box_t centers;
+    S min_radius;
+    S max_radius;
+    uint32_t first;
+    uint32_t last;
+    // Index of the first child, the second one follows. 0 for leaves.
+    uint32_t children;
+  };
+
+  // Bit i of s set means that coordinate i is subtracted in u_s
+  static constexpr bool is_subtracted(size_t s, size_t i) {
+    return i > 0 && ((s >> (i - 1)) & 1) != 0;
+  }
+
+  static rotated_box_t rotate(const box_t &b) {
+    rotated_box_t res;
+    for (size_t s = 0; s < K; ++s) {
+      S min{}, max{};
+      for (size_t i = 0; i < M; ++i) {
+        if (is_subtracted(s, i)) {
+          min -= b.max[i];
+          max -= b.min[i];
+        } else {
+          min += b.min[i];
+          max += b.max[i];
+        }
+      }
+      res.min[s] = min;
+      res.max[s] = max;
+    }
+    return res;
+  }
+
+  static rotated_box_t rotate(const ball_t &ball) {
+    auto res = rotate(box_t{ball.center, ball.center});
+    for (size_t s = 0; s < K; ++s) {
+      res.min[s] -= ball.radius;
+      res.max[s] += ball.radius;
+    }
+    return res;
+  }
+
+  // Smallest distance from a point of `centers` to a point of `b`
+  static S min_distance(const box_t &centers, const box_t &b) {
+    S res{};
+    for (size_t i = 0; i < M; ++i) {
+      res += std::max({S{}, static_cast<S>(b.min[i] - centers.max[i]),
+                       static_cast<S>(centers.min[i] - b.max[i])});
+    }
+    return res;
+  }
+
+  // Largest distance from a point of `centers` to its closest point of `b`
+  static S max_distance(const box_t &centers, const box_t &b) {
+    S res{};
+    for (size_t i = 0; i < M; ++i) {
+      res += std::max({S{}, static_cast<S>(b.min[i] - centers.min[i]),
+                       static_cast<S>(centers.max[i] - b.max[i])});
+    }
+    return res;
+  }
+
+  void build(size_t n, size_t lo, size_t hi) {
+    node_t node{.rotated = rotate(m_balls[lo]),
+                .centers = {m_balls[lo].center, m_balls[lo].center},
+                .min_radius = m_balls[lo].radius,
+                .max_radius = m_balls[lo].radius,
+                .first = static_cast<uint32_t>(lo),
+                .last = static_cast<uint32_t>(hi),
+                .children = 0};
+    for (size_t i = lo + 1; i < hi; ++i) {
+      node.rotated.extend(rotate(m_balls[i]));
+      node.centers.extend({m_balls[i].center, m_balls[i].center});
+      node.min_radius = std::min(node.min_radius, m_balls[i].radius);
+      node.max_radius = std::max(node.max_radius, m_balls[i].radius);
+    }
+    if (hi - lo <= leaf_size) {
+      m_nodes[n] = node;
+      return;
+    }
+
+    size_t axis = 0;
+    for (size_t i = 1; i < M; ++i) {
+      if (node.centers.max[i] - node.centers.min[i] >
+          node.centers.max[axis] - node.centers.min[axis]) {
+        axis = i;
+      }
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    std::ranges::nth_element(
+        m_balls.begin() + lo, m_balls.begin() + mid, m_balls.begin() + hi, {},
+        [axis](const ball_t &ball) { return ball.center[axis]; });
+
+    node.children = static_cast<uint32_t>(m_nodes.size());
+    m_nodes[n] = node;
+    m_nodes.resize(m_nodes.size() + 2);
+    build(node.children, lo, mid);
+    build(node.children + 1, mid, hi);
+  }
+
+  size_t count_intersecting(size_t n, const box_t &b,
+                            const rotated_box_t &rotated) const {
+    const node_t &node = m_nodes[n];
+    if (!node.rotated.intersects(rotated) ||
+        min_distance(node.centers, b) > node.max_radius) {
+      return 0;
+    }
+    if (max_distance(node.centers, b) <= node.min_radius) {
+      return node.last - node.first;
+    }
+    if (node.children == 0) {
+      return static_cast<size_t>(std::ranges::count_if(
+          m_balls.begin() + node.first, m_balls.begin() + node.last,
+          [&b](const ball_t &ball) {
+            return min_distance({ball.center, ball.center}, b) <= ball.radius;
+          }));
+    }
+    return count_intersecting(node.children, b, rotated) +
+           count_intersecting(node.children + 1, b, rotated);
+  }
+
+  std::vector<ball_t> m_balls;
+  std::vector<node_t> m_nodes;
+};
+
+template <std::ranges::input_range R>
+manhattan_ball_index(std::from_range_t, R &&) -> manhattan_ball_index<
+    decltype(std::ranges::range_value_t<R>::radius),
+    dimensions<decltype(std::ranges::range_value_t<R>::center)>::M()>;
+
+} // namespace aoc
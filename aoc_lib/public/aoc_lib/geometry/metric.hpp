@@ -0,0 +1,44 @@
+#pragma once
+
+#include <aoc_lib/geometry/point.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <utility>
+
+namespace aoc {
+
+namespace metric {
+struct manhattan_t {};
+constexpr manhattan_t manhattan;
+
+struct squared_euclidean_t {};
+constexpr squared_euclidean_t squared_euclidean;
+
+// Contribution of the coordinates a and b along one axis to the distance. It
+// is also a lower bound of the distance from a to anything on the other side
+// of the plane through b orthogonal to that axis. The difference is taken as
+// max - min, which neither wraps for unsigned coordinates nor needs an abs.
+template <scalar S> constexpr S distance_term(manhattan_t, S a, S b) {
+  return static_cast<S>(std::max(a, b) - std::min(a, b));
+}
+
+template <scalar S> constexpr S distance_term(squared_euclidean_t, S a, S b) {
+  const auto diff = static_cast<S>(std::max(a, b) - std::min(a, b));
+  return static_cast<S>(diff * diff);
+}
+} // namespace metric
+
+template <typename T>
+concept distance_metric = std::same_as<T, metric::manhattan_t> ||
+                          std::same_as<T, metric::squared_euclidean_t>;
+
+template <distance_metric Metric, scalar S, size_t M>
+constexpr S distance(Metric metric, const point<S, M> &l,
+                     const point<S, M> &r) {
+  return [&]<size_t... I>(std::index_sequence<I...>) {
+    return (S{} + ... + metric::distance_term(metric, l[I], r[I]));
+  }(std::make_index_sequence<M>());
+}
+
+} // namespace aoc
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <aoc_lib/geometry/algorithm.hpp>
+#include <aoc_lib/geometry/dyn_matrix.hpp>
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// Matrix surrounded by a border of sentinel cells. Cells are addressed by
+// their flat index in the padded storage, so that moving to a neighbour is
+// adding one of the offsets() to an index: as long as the walk stays within
+// the border, it needs no bounds checks.
+template <typename T> class padded_matrix {
+public:
+  using point_t = point2d<size_t>;
+
+  padded_matrix() = default;
+
+  padded_matrix(const dyn_matrix<T> &inner, size_t border, const T &sentinel)
+      : m_width(inner.width()), m_height(inner.height()), m_border(border),
+        m_cells((m_width + 2 * border) * (m_height + 2 * border), sentinel) {
+    for (size_t m = 0; m < m_height; ++m) {
+      std::ranges::copy(inner.row(m), m_cells.begin() + index(m, 0));
+    }
+  }
+
+  // Dimensions of the inner matrix
+  size_t width() const { return m_width; }
+  size_t height() const { return m_height; }
+
+  size_t border() const { return m_border; }
+
+  // Distance in flat indices between two vertically adjacent cells
+  size_t stride() const { return m_width + 2 * m_border; }
+
+  // Number of cells, border included
+  size_t size() const { return m_cells.size(); }
+
+  size_t index(size_t m, size_t n) const {
+    return (m + m_border) * stride() + n + m_border;
+  }
+
+  size_t index(const point_t &p) const { return index(p.y(), p.x()); }
+
+  point_t position(size_t index) const {
+    return {index % stride() - m_border, index / stride() - m_border};
+  }
+
+  ptrdiff_t offset(ptrdiff_t dm, ptrdiff_t dn) const {
+    return dm * static_cast<ptrdiff_t>(stride()) + dn;
+  }
+
+  std::array<ptrdiff_t, 4> offsets(adjacent_type::manhattan_t) const {
+    return {offset(-1, 0), offset(0, -1), offset(0, 1), offset(1, 0)};
+  }
+
+  std::array<ptrdiff_t, 8> offsets(adjacent_type::euclidean_t) const {
+    return {offset(-1, -1), offset(-1, 0), offset(-1, 1), offset(0, -1),
+            offset(0, 1),   offset(1, -1), offset(1, 0),  offset(1, 1)};
+  }
+
+  template <typename Self>
+  constexpr decltype(auto) operator[](this Self &&self, size_t index) {
+    return std::forward_like<Self>(self.m_cells[index]);
+  }
+
+  template <typename Self>
+  constexpr decltype(auto) operator[](this Self &&self, const point_t &p) {
+    return std::forward<Self>(self)[self.index(p)];
+  }
+
+  template <typename Self>
+  constexpr decltype(auto) at(this Self &&self, size_t m, size_t n) {
+    return std::forward<Self>(self)[self.index(m, n)];
+  }
+
+  // Inner cells of row m
+  template <typename Self> auto row(this Self &&self, size_t m) {
+    return std::span(self.m_cells).subspan(self.index(m, 0), self.m_width);
+  }
+
+  // Every cell, border included, by flat index
+  template <typename Self> auto data(this Self &&self) {
+    return std::span(self.m_cells);
+  }
+
+  // Flat indices of the inner cells, in row order
+  std::ranges::view auto indices() const {
+    return std::views::iota(size_t{}, height()) |
+           std::views::transform([this](size_t m) {
+             return std::views::iota(index(m, 0), index(m, 0) + width());
+           }) |
+           std::views::join;
+  }
+
+  dyn_matrix<T> inner() const {
+    auto res = dyn_matrix<T>(width(), height());
+    for (size_t m = 0; m < height(); ++m) {
+      const auto first = m_cells.begin() + index(m, 0);
+      std::ranges::copy(first, first + width(), res.row(m).begin());
+    }
+    return res;
+  }
+
+  bool operator==(const padded_matrix &) const = default;
+
+private:
+  size_t m_width = 0;
+  size_t m_height = 0;
+  size_t m_border = 0;
+  std::vector<T> m_cells;
+};
+
+} // namespace aoc
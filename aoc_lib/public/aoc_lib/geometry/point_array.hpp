@@ -0,0 +1,197 @@
+#pragma once
+
+#include <aoc_lib/geometry/metric.hpp>
+#include <aoc_lib/geometry/point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Set of points stored as one array per coordinate, so that the distances from
+// one point to all the others are computed by loops the compiler vectorises.
+template <scalar S, size_t M> class point_array {
+public:
+  using point_t = point<S, M>;
+
+  point_array() = default;
+
+  template <std::ranges::input_range R>
+  point_array(std::from_range_t, R &&points) {
+    if constexpr (std::ranges::sized_range<R>) {
+      reserve(std::ranges::size(points));
+    }
+    for (const point_t &p : points) {
+      push_back(p);
+    }
+  }
+
+  void reserve(size_t n) {
+    for (auto &coords : m_coords) {
+      coords.reserve(n);
+    }
+  }
+
+  void push_back(const point_t &p) {
+    for (size_t d = 0; d < M; ++d) {
+      m_coords[d].push_back(p[d]);
+    }
+  }
+
+  size_t size() const { return m_coords[0].size(); }
+  bool empty() const { return m_coords[0].empty(); }
+
+  point_t operator[](size_t i) const {
+    return [this, i]<size_t... D>(std::index_sequence<D...>) {
+      return point_t{m_coords[D][i]...};
+    }(std::make_index_sequence<M>());
+  }
+
+  std::span<const S> coordinates(size_t d) const { return m_coords[d]; }
+
+  // Writes the distance from `from` to each point in `out`, which must hold
+  // size() elements.
+  template <distance_metric Metric>
+  void distances(const point_t &from, Metric metric, std::span<S> out) const {
+    block_distances(from, metric, 0, out.first(size()));
+  }
+
+  // Index of the first closest point and its distance, the array must not be
+  // empty.
+  template <distance_metric Metric>
+  std::pair<size_t, S> nearest(const point_t &from, Metric metric) const {
+    auto best = std::make_pair(size_t{}, std::numeric_limits<S>::max());
+    for_each_block(from, metric, 0,
+                   [&best](size_t offset, std::span<const S> dists) {
+                     for (size_t i = 0; i < dists.size(); ++i) {
+                       if (dists[i] < best.second) {
+                         best = {offset + i, dists[i]};
+                       }
+                     }
+                   });
+    return best;
+  }
+
+  // Index of the closest point, or nullopt if several points are the closest
+  template <distance_metric Metric>
+  std::optional<size_t> unique_nearest(const point_t &from,
+                                       Metric metric) const {
+    return unique_nearest_and_sum(from, metric).first;
+  }
+
+  // unique_nearest and sum_of_distances together, from a single pass over the
+  // distances
+  template <distance_metric Metric>
+  std::pair<std::optional<size_t>, S>
+  unique_nearest_and_sum(const point_t &from, Metric metric) const {
+    size_t best = 0;
+    size_t best_count = 0;
+    S best_dist = std::numeric_limits<S>::max();
+    S sum{};
+    for_each_block(from, metric, 0,
+                   [&](size_t offset, std::span<const S> dists) {
+                     for (size_t i = 0; i < dists.size(); ++i) {
+                       if (dists[i] < best_dist) {
+                         best = offset + i;
+                         best_count = 1;
+                         best_dist = dists[i];
+                       } else if (dists[i] == best_dist) {
+                         ++best_count;
+                       }
+                       sum += dists[i];
+                     }
+                   });
+    if (best_count != 1) {
+      return {std::nullopt, sum};
+    }
+    return {best, sum};
+  }
+
+  template <distance_metric Metric>
+  S sum_of_distances(const point_t &from, Metric metric) const {
+    S res{};
+    for_each_block(from, metric, 0, [&res](size_t, std::span<const S> dists) {
+      for (S dist : dists) {
+        res += dist;
+      }
+    });
+    return res;
+  }
+
+  // Number of points at a distance of at most `radius` from `from`
+  template <distance_metric Metric>
+  size_t count_within(const point_t &from, S radius, Metric metric) const {
+    size_t res = 0;
+    for_each_block(from, metric, 0,
+                   [&res, radius](size_t, std::span<const S> dists) {
+                     for (S dist : dists) {
+                       res += dist <= radius;
+                     }
+                   });
+    return res;
+  }
+
+  // Calls func(i, j) for every pair of points i < j at a distance of at most
+  // `radius` from each other, ordered by i then j.
+  template <distance_metric Metric, typename F>
+  void for_each_pair_within(S radius, Metric metric, F &&func) const {
+    for (size_t i = 0; i + 1 < size(); ++i) {
+      for_each_block((*this)[i], metric, i + 1,
+                     [&](size_t offset, std::span<const S> dists) {
+                       for (size_t j = 0; j < dists.size(); ++j) {
+                         if (dists[j] <= radius) {
+                           func(i, offset + j);
+                         }
+                       }
+                     });
+    }
+  }
+
+private:
+  // Distances are computed by blocks small enough to stay in L1
+  static constexpr size_t block_size = 256;
+
+  template <distance_metric Metric>
+  void block_distances(const point_t &from, Metric metric, size_t offset,
+                       std::span<S> out) const {
+    const S *first = m_coords[0].data() + offset;
+    const S f0 = from[0];
+    for (size_t i = 0; i < out.size(); ++i) {
+      out[i] = metric::distance_term(metric, first[i], f0);
+    }
+    for (size_t d = 1; d < M; ++d) {
+      const S *coords = m_coords[d].data() + offset;
+      const S f = from[d];
+      for (size_t i = 0; i < out.size(); ++i) {
+        out[i] += metric::distance_term(metric, coords[i], f);
+      }
+    }
+  }
+
+  template <distance_metric Metric, typename F>
+  void for_each_block(const point_t &from, Metric metric, size_t first,
+                      F &&func) const {
+    std::array<S, block_size> buffer;
+    for (size_t offset = first; offset < size(); offset += block_size) {
+      const auto dists = std::span(buffer).first(
+          std::min(block_size, size() - offset));
+      block_distances(from, metric, offset, dists);
+      func(offset, std::span<const S>(dists));
+    }
+  }
+
+  std::array<std::vector<S>, M> m_coords;
+};
+
+template <std::ranges::input_range R>
+point_array(std::from_range_t, R &&)
+    -> point_array<typename std::ranges::range_value_t<R>::value_type,
+                   dimensions<std::ranges::range_value_t<R>>::M()>;
+
+} // namespace aoc
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <aoc_lib/geometry/dyn_matrix.hpp>
+#include <aoc_lib/parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace aoc {
+
+// Summed area table: the sum of any rectangle of a matrix in constant time.
+// Sums are stored with a leading row and column of zeros, so that no lookup
+// needs a bounds check.
+template <typename T> class prefix_sum_2d {
+public:
+  using point_t = point2d<size_t>;
+
+  // Square of cells, by its top left corner
+  struct window_t {
+    T sum;
+    point_t top_left;
+    size_t size;
+  };
+
+  prefix_sum_2d() = default;
+
+  explicit prefix_sum_2d(const dyn_matrix<T> &values)
+      : m_sums(values.width() + 1, values.height() + 1) {
+    for (size_t m = 0; m < values.height(); ++m) {
+      const auto above = m_sums.row(m);
+      const auto row = m_sums.row(m + 1);
+      T line{};
+      for (size_t n = 0; n < values.width(); ++n) {
+        line += values[m, n];
+        row[n + 1] = above[n + 1] + line;
+      }
+    }
+  }
+
+  // Dimensions of the summed matrix
+  size_t width() const { return m_sums.width() - 1; }
+  size_t height() const { return m_sums.height() - 1; }
+
+  // Sum of the cells of rows [m, m + height) and columns [n, n + width)
+  T sum(size_t m, size_t n, size_t height, size_t width) const {
+    return m_sums[m + height, n + width] - m_sums[m, n + width] -
+           m_sums[m + height, n] + m_sums[m, n];
+  }
+
+  T sum(const window_t &window) const {
+    return sum(window.top_left.y(), window.top_left.x(), window.size,
+               window.size);
+  }
+
+  // Window of the given size with the largest sum, the leftmost one then the
+  // topmost one on ties. The sums of a whole row of windows are computed
+  // together, in a loop the compiler can vectorize.
+  std::optional<window_t> best_window(size_t size) const {
+    if (size == 0 || size > width() || size > height()) {
+      return std::nullopt;
+    }
+    const size_t count = width() - size + 1;
+    std::vector<T> sums(count);
+    std::optional<window_t> best;
+    for (size_t m = 0; m + size <= height(); ++m) {
+      const T *top = m_sums.row(m).data();
+      const T *bottom = m_sums.row(m + size).data();
+      for (size_t n = 0; n < count; ++n) {
+        sums[n] = bottom[n + size] - top[n + size] - bottom[n] + top[n];
+      }
+      const auto max = std::ranges::max_element(sums);
+      const auto candidate =
+          window_t{*max, {static_cast<size_t>(max - sums.begin()), m}, size};
+      if (!best || is_better(candidate, *best)) {
+        best = candidate;
+      }
+    }
+    return best;
+  }
+
+  // Best window among the sizes in [min_size, max_size], the smallest one on
+  // ties. Sizes are searched in parallel.
+  std::optional<window_t> best_window(size_t min_size, size_t max_size) const {
+    max_size = std::min({max_size, width(), height()});
+    if (min_size > max_size) {
+      return std::nullopt;
+    }
+    return parallel_transform_reduce(
+        std::views::iota(min_size, max_size + 1), std::optional<window_t>(),
+        [](const std::optional<window_t> &l, const std::optional<window_t> &r) {
+          return l && (!r || is_better(*l, *r)) ? l : r;
+        },
+        [this](size_t size) { return best_window(size); });
+  }
+
+private:
+  static bool is_better(const window_t &l, const window_t &r) {
+    if (l.sum != r.sum) {
+      return l.sum > r.sum;
+    }
+    if (l.size != r.size) {
+      return l.size < r.size;
+    }
+    if (l.top_left.x() != r.top_left.x()) {
+      return l.top_left.x() < r.top_left.x();
+    }
+    return l.top_left.y() < r.top_left.y();
+  }
+
+  dyn_matrix<T> m_sums;
+};
+
+} // namespace aoc
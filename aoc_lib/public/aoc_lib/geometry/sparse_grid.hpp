@@ -0,0 +1,169 @@
+#pragma once
+
+#include <aoc_lib/flat_map.hpp>
+#include <aoc_lib/geometry/point.hpp>
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// Unbounded 2D grid, negative coordinates included. Cells are stored in dense
+// square tiles that are allocated the first time one of their cells is
+// written; cells that were never written read as the default value.
+template <typename T, size_t TileSize = 64> class sparse_grid {
+  static_assert(std::has_single_bit(TileSize), "TileSize must be a power of 2");
+
+public:
+  using point_t = point2d<int64_t>;
+
+  struct tile_t {
+    point_t origin;
+    std::array<T, TileSize * TileSize> cells;
+  };
+
+  // Read only view of the tile holding a point and of the 8 tiles around it.
+  // The tiles are looked up once, so that stencils reading the neighbours of
+  // every cell of a tile do not need a hash lookup per cell. The view is valid
+  // until the grid is next written to.
+  class neighbourhood_t {
+  public:
+    // p must lie in one of the 9 tiles of the view
+    const T &get(point_t p) const {
+      const point_t key = tile_key(p);
+      const int64_t dx = key.x() - m_center_key.x() + 1;
+      const int64_t dy = key.y() - m_center_key.y() + 1;
+      assert(dx >= 0 && dx < 3 && dy >= 0 && dy < 3);
+      const tile_t *tile = m_tiles[static_cast<size_t>(dy * 3 + dx)];
+      return tile ? tile->cells[cell_index(p)] : *m_default;
+    }
+
+  private:
+    friend class sparse_grid;
+
+    point_t m_center_key;
+    std::array<const tile_t *, 9> m_tiles{};
+    const T *m_default = nullptr;
+  };
+
+  sparse_grid() = default;
+
+  explicit sparse_grid(const T &default_value) : m_default(default_value) {}
+
+  // Reading a const grid writes nothing, so that threads can share it
+  const T &get(point_t p) const {
+    const auto found = m_index.find(tile_key(p));
+    return found != m_index.end() ? m_tiles[found->second].cells[cell_index(p)]
+                                  : m_default;
+  }
+
+  // Walks usually stay within a tile for a while, so reading through a
+  // mutable grid remembers the last tile looked up to skip the hash lookup.
+  const T &get(point_t p) {
+    const size_t tile = find_tile(tile_key(p));
+    return tile != no_tile ? m_tiles[tile].cells[cell_index(p)] : m_default;
+  }
+
+  neighbourhood_t neighbourhood(point_t p) const {
+    auto res = neighbourhood_t();
+    res.m_center_key = tile_key(p);
+    res.m_default = &m_default;
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      for (int64_t dx = -1; dx <= 1; ++dx) {
+        const auto found = m_index.find(
+            point_t{res.m_center_key.x() + dx, res.m_center_key.y() + dy});
+        if (found != m_index.end()) {
+          res.m_tiles[static_cast<size_t>((dy + 1) * 3 + dx + 1)] =
+              &m_tiles[found->second];
+        }
+      }
+    }
+    return res;
+  }
+
+  T &operator[](point_t p) {
+    return m_tiles[tile_for(tile_key(p))].cells[cell_index(p)];
+  }
+
+  void set(point_t p, T value) { (*this)[p] = std::move(value); }
+
+  const T &default_value() const { return m_default; }
+
+  std::span<const tile_t> tiles() const { return m_tiles; }
+
+  // Every cell of the allocated tiles, tile after tile
+  std::ranges::view auto values() const {
+    return m_tiles | std::views::transform(&tile_t::cells) | std::views::join;
+  }
+
+  std::ranges::view auto enumerate() const {
+    return m_tiles | std::views::transform([](const tile_t &tile) {
+             return std::views::zip(cell_points(tile.origin), tile.cells);
+           }) |
+           std::views::join;
+  }
+
+private:
+  static constexpr int64_t tile_size = TileSize;
+  static constexpr int tile_shift = std::countr_zero(TileSize);
+  static constexpr size_t no_tile = std::numeric_limits<size_t>::max();
+
+  // Arithmetic shifts round towards negative infinity, so negative coordinates
+  // land in their own tiles instead of sharing tile 0.
+  static point_t tile_key(point_t p) {
+    return {p.x() >> tile_shift, p.y() >> tile_shift};
+  }
+
+  static auto cell_points(point_t origin) {
+    return std::views::iota(int64_t{}, tile_size * tile_size) |
+           std::views::transform([origin](int64_t i) {
+             return point_t{origin.x() + i % tile_size,
+                            origin.y() + i / tile_size};
+           });
+  }
+
+  static size_t cell_index(point_t p) {
+    return static_cast<size_t>((p.y() & (tile_size - 1)) * tile_size +
+                               (p.x() & (tile_size - 1)));
+  }
+
+  size_t find_tile(point_t key) {
+    if (m_cached_tile != no_tile && m_cached_key == key) {
+      return m_cached_tile;
+    }
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+      return no_tile;
+    }
+    m_cached_key = key;
+    m_cached_tile = found->second;
+    return m_cached_tile;
+  }
+
+  size_t tile_for(point_t key) {
+    if (const size_t tile = find_tile(key); tile != no_tile) {
+      return tile;
+    }
+    m_cached_key = key;
+    m_cached_tile = m_tiles.size();
+    m_index.try_emplace(key, m_tiles.size());
+    auto &tile = m_tiles.emplace_back(
+        point_t{key.x() * tile_size, key.y() * tile_size});
+    tile.cells.fill(m_default);
+    return m_cached_tile;
+  }
+
+  T m_default{};
+  std::vector<tile_t> m_tiles;
+  flat_map<point_t, size_t> m_index;
+  point_t m_cached_key{};
+  size_t m_cached_tile = no_tile;
+};
+
+} // namespace aoc
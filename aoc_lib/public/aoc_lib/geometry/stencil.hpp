@@ -0,0 +1,123 @@
+#pragma once
+
+#include <aoc_lib/geometry/bit_matrix.hpp>
+#include <aoc_lib/geometry/padded_matrix.hpp>
+#include <aoc_lib/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace aoc {
+
+// Cells around one cell of a padded_matrix, as seen by a stencil rule
+template <typename T, size_t N> class stencil_neighbours {
+public:
+  stencil_neighbours(const T *center, const std::array<ptrdiff_t, N> &offsets)
+      : m_center(center), m_offsets(offsets) {}
+
+  static constexpr size_t size() { return N; }
+
+  const T &operator[](size_t k) const { return m_center[m_offsets[k]]; }
+
+  // Branchless, so that rules only made of counts vectorize along the row
+  size_t count(const T &value) const {
+    size_t res = 0;
+    for (ptrdiff_t offset : m_offsets) {
+      res += m_center[offset] == value;
+    }
+    return res;
+  }
+
+private:
+  const T *m_center;
+  const std::array<ptrdiff_t, N> &m_offsets;
+};
+
+// Cellular automaton over a padded_matrix. Each step computes every inner cell
+// from the previous generation with rule(cell, neighbours), into a second
+// buffer that then becomes the current one. The border keeps its sentinel
+// value, and must be at least as wide as the neighbourhood reaches.
+template <typename T> class stencil {
+public:
+  explicit stencil(padded_matrix<T> grid)
+      : m_current(std::move(grid)), m_next(m_current) {}
+
+  const padded_matrix<T> &grid() const { return m_current; }
+
+  // Neighbourhood given as flat offsets, see padded_matrix::offsets(). Bands
+  // of rows of large grids are stepped in parallel, so the rule must be safe
+  // to call concurrently.
+  template <size_t N, typename Rule>
+  void step(const std::array<ptrdiff_t, N> &offsets, Rule &&rule) {
+    const T *from = m_current.data().data();
+    T *to = m_next.data().data();
+    auto step_row = [&](size_t m) {
+      const size_t begin = m_current.index(m, 0);
+      const size_t end = begin + m_current.width();
+      for (size_t i = begin; i < end; ++i) {
+        to[i] = rule(from[i], stencil_neighbours<T, N>(from + i, offsets));
+      }
+    };
+    // Smaller bands would cost more to hand out than to step
+    constexpr size_t min_band_cells = 4096;
+    parallel_for(m_current.height(), step_row,
+                 min_band_cells / std::max(m_current.width(), size_t{1}));
+    std::swap(m_current, m_next);
+  }
+
+  template <typename Shape, typename Rule>
+    requires requires(const padded_matrix<T> &grid, Shape shape) {
+      grid.offsets(shape);
+    }
+  void step(Shape shape, Rule &&rule) {
+    step(m_current.offsets(shape), std::forward<Rule>(rule));
+  }
+
+private:
+  padded_matrix<T> m_current;
+  padded_matrix<T> m_next;
+};
+
+template <typename T> stencil(padded_matrix<T>) -> stencil<T>;
+
+// Rule deciding a cell from its number of set neighbours: bit k of born tells
+// whether a cleared cell with k set neighbours gets set, bit k of survives
+// whether a set one stays set.
+struct count_rule {
+  uint32_t born = 0;
+  uint32_t survives = 0;
+};
+
+// Cellular automaton over a bit_matrix whose rule only depends on neighbour
+// counts. A step computes whole words of 64 cells at once, keeping the counts
+// bit sliced: bit j of plane p is bit p of the count of cell j. Cells outside
+// of the matrix count as cleared.
+class bit_stencil {
+public:
+  // Offset of a neighbour, in rows and columns
+  struct offset_t {
+    ptrdiff_t dm;
+    ptrdiff_t dn;
+  };
+
+  explicit bit_stencil(bit_matrix grid)
+      : m_current(std::move(grid)), m_next(m_current) {}
+
+  const bit_matrix &grid() const { return m_current; }
+
+  // Neighbourhoods hold fewer than 32 cells, less than 64 columns away. Bands
+  // of rows of large grids are stepped in parallel.
+  void step(std::span<const offset_t> offsets, count_rule rule);
+  void step(adjacent_type::manhattan_t, count_rule rule);
+  void step(adjacent_type::euclidean_t, count_rule rule);
+
+private:
+  bit_matrix m_current;
+  bit_matrix m_next;
+};
+
+} // namespace aoc
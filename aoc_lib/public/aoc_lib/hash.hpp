@@ -1,19 +1,59 @@
 #pragma once
 
-#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace aoc {
 
+namespace detail {
+// Secrets from rapidhash
+inline constexpr uint64_t hash_secret[] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull};
+
+// Full 64x64 -> 128 bits multiplication, folded back to 64 bits
+inline uint64_t folded_multiply(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  uint64_t high;
+  const uint64_t low = _umul128(a, b, &high);
+  return low ^ high;
+#else
+  const uint64_t ll = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+  const uint64_t lh = (a & 0xFFFFFFFF) * (b >> 32);
+  const uint64_t hl = (a >> 32) * (b & 0xFFFFFFFF);
+  const uint64_t hh = (a >> 32) * (b >> 32);
+  const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+  const uint64_t low = (ll & 0xFFFFFFFF) | (mid << 32);
+  const uint64_t high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return low ^ high;
+#endif
+}
+} // namespace detail
+
+// wyhash/rapidhash mixing step: every bit of the result depends on every bit
+// of both inputs, and swapping the inputs gives a different result.
+inline size_t hash_mix(uint64_t a, uint64_t b) {
+  return static_cast<size_t>(detail::folded_multiply(
+      a ^ detail::hash_secret[0], b ^ detail::hash_secret[1]));
+}
+
 class hash_accumulator {
 public:
-  void accumulate(size_t hash);
+  void accumulate(size_t hash) { m_hash = hash_mix(m_hash, hash); }
 
-  size_t result() const;
+  size_t result() const { return m_hash; }
 
 private:
-  size_t m_hash = 0;
+  size_t m_hash = detail::hash_secret[2];
 };
 
 size_t hash_combine(std::initializer_list<size_t> hashes);
 
-}
\ No newline at end of file
+} // namespace aoc
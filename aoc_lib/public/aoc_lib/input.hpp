@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -12,6 +13,8 @@ struct arguments {
   bool is_example = false;
   std::optional<part> selected_part;
   std::optional<std::string> expected_output;
+  // Threads of the parallel algorithms, one per core if unset
+  std::optional<size_t> threads;
 
   operator const std::string &() const { return input; }
   operator std::string_view() const { return input; }
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <aoc_lib/flat_map.hpp>
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+// Maps strings to consecutive ids, in order of first appearance, so that
+// data about them can be stored in dense arrays indexed by id. The table owns
+// a copy of every string, so the interned views can outlive the input.
+template <std::unsigned_integral Id = uint32_t> class interner {
+public:
+  interner() = default;
+
+  interner(std::initializer_list<std::string_view> strings) {
+    for (std::string_view s : strings) {
+      intern(s);
+    }
+  }
+
+  // Views into m_strings would dangle in a copy
+  interner(const interner &) = delete;
+  interner &operator=(const interner &) = delete;
+  interner(interner &&) = default;
+  interner &operator=(interner &&) = default;
+
+  // Number of strings interned, all ids are below it
+  size_t size() const { return m_strings.size(); }
+
+  // Id of s, which is interned first if it is new
+  Id intern(std::string_view s) {
+    if (auto found = m_ids.find(s); found != m_ids.end()) {
+      return found->second;
+    }
+    if (m_strings.size() > std::numeric_limits<Id>::max()) {
+      throw std::length_error("Too many strings to intern");
+    }
+    const auto id = static_cast<Id>(m_strings.size());
+    m_ids.try_emplace(m_strings.emplace_back(s), id);
+    return id;
+  }
+
+  // Id of s, if it was interned
+  std::optional<Id> find(std::string_view s) const {
+    if (auto found = m_ids.find(s); found != m_ids.end()) {
+      return found->second;
+    }
+    return std::nullopt;
+  }
+
+  // String with the given id
+  std::string_view operator[](Id id) const {
+    assert(id < m_strings.size());
+    return m_strings[id];
+  }
+
+private:
+  // A deque never moves its elements, nor their small string buffers
+  std::deque<std::string> m_strings;
+  flat_map<std::string_view, Id> m_ids;
+};
+
+} // namespace aoc
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <map>
+
+namespace aoc {
+
+// Set of integers stored as disjoint inclusive intervals, sorted by their
+// first value. Intervals that overlap or touch are merged on insertion, so
+// that lookups only have to check the interval starting right before the
+// value.
+template <std::integral T> class interval_set {
+public:
+  // Maps the first value of each interval to its last one
+  using const_iterator = typename std::map<T, T>::const_iterator;
+
+  bool empty() const { return m_intervals.empty(); }
+
+  // Number of disjoint intervals
+  size_t size() const { return m_intervals.size(); }
+
+  // Number of values in the set
+  T length() const { return m_length; }
+
+  const_iterator begin() const { return m_intervals.begin(); }
+  const_iterator end() const { return m_intervals.end(); }
+
+  // Adds every value of [from, to]
+  void insert(T from, T to) {
+    assert(from <= to);
+    auto it = m_intervals.upper_bound(from);
+    if (it != m_intervals.begin()) {
+      if (auto previous = std::prev(it); reaches(previous->second, from)) {
+        it = previous;
+      }
+    }
+    while (it != m_intervals.end() && reaches(to, it->first)) {
+      from = std::min(from, it->first);
+      to = std::max(to, it->second);
+      m_length -= it->second - it->first + 1;
+      it = m_intervals.erase(it);
+    }
+    m_intervals.emplace_hint(it, from, to);
+    m_length += to - from + 1;
+  }
+
+  // Interval containing v, or end()
+  const_iterator find(T v) const {
+    auto it = m_intervals.upper_bound(v);
+    if (it == m_intervals.begin()) {
+      return m_intervals.end();
+    }
+    --it;
+    return v <= it->second ? it : m_intervals.end();
+  }
+
+  bool contains(T v) const { return find(v) != m_intervals.end(); }
+
+private:
+  // Whether an interval ending at `to` overlaps or touches one starting at
+  // `from`
+  static bool reaches(T to, T from) { return from <= to || from - to == 1; }
+
+  std::map<T, T> m_intervals;
+  T m_length{};
+};
+
+} // namespace aoc
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Memoised results of a function over keys with a dense index in [0, size),
+// stored in a flat array where `unset` marks the keys not computed yet.
+//
+// Results are computed by compute(key, lookup), where lookup(other) gives the
+// result for another key. recursive() evaluates lookups with plain recursion,
+// iterative() with an explicit stack, for dependency chains too long for the
+// call stack. Dependencies must not form a cycle.
+template <typename Key, typename Value, std::invocable<const Key &> Index>
+class memo {
+public:
+  memo(size_t size, Index index, Value unset)
+      : m_values(size, unset), m_index(std::move(index)),
+        m_unset(std::move(unset)) {}
+
+  size_t size() const { return m_values.size(); }
+
+  std::optional<Value> find(const Key &key) const {
+    const Value &value = m_values[index(key)];
+    if (value == m_unset) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  template <typename Compute>
+  Value recursive(const Key &key, Compute &&compute) {
+    const size_t i = index(key);
+    if (m_values[i] != m_unset) {
+      return m_values[i];
+    }
+    Value value = std::invoke(compute, key, [&](const Key &other) {
+      return recursive(other, compute);
+    });
+    assert(value != m_unset);
+    m_values[i] = value;
+    return value;
+  }
+
+  // Lookups of keys not computed yet give Value{} and are put on the stack,
+  // and the key is computed again once they are known. compute must thus only
+  // have side effects that can be repeated.
+  template <typename Compute>
+  Value iterative(const Key &key, Compute &&compute) {
+    std::vector<Key> stack{key};
+    std::vector<Key> missing;
+    auto lookup = [&](const Key &other) -> Value {
+      const Value &value = m_values[index(other)];
+      if (value == m_unset) {
+        missing.push_back(other);
+        return Value{};
+      }
+      return value;
+    };
+    while (!stack.empty()) {
+      const Key cur = stack.back();
+      const size_t i = index(cur);
+      // Keys needed several times may already have been computed
+      if (m_values[i] != m_unset) {
+        stack.pop_back();
+        continue;
+      }
+      missing.clear();
+      Value value = std::invoke(compute, cur, lookup);
+      if (missing.empty()) {
+        assert(value != m_unset);
+        m_values[i] = std::move(value);
+        stack.pop_back();
+      } else {
+        stack.insert(stack.end(), missing.begin(), missing.end());
+      }
+    }
+    return m_values[index(key)];
+  }
+
+private:
+  size_t index(const Key &key) const {
+    const size_t i = std::invoke(m_index, key);
+    assert(i < m_values.size());
+    return i;
+  }
+
+  std::vector<Value> m_values;
+  Index m_index;
+  Value m_unset;
+};
+
+// Memo for `size` keys numbered by index(key). Key and Value have to be given
+// explicitly.
+template <typename Key, typename Value, std::invocable<const Key &> Index>
+memo<Key, Value, Index>
+make_memo(size_t size, Index index,
+          Value unset = std::numeric_limits<Value>::max()) {
+  return {size, std::move(index), std::move(unset)};
+}
+
+} // namespace aoc
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <aoc_lib/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Parallel algorithms over the current thread_pool, see thread_pool_scope.
+// Without one, they run on the calling thread. Work is split in contiguous
+// chunks, a few per thread, so the functions given must be safe to call
+// concurrently.
+namespace aoc {
+
+template <typename R>
+concept parallel_range =
+    std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+// Number of threads the parallel algorithms use
+inline size_t concurrency() {
+  const thread_pool *pool = thread_pool::current();
+  return pool ? pool->concurrency() : 1;
+}
+
+namespace detail {
+// Number of chunks to split count items in, none smaller than min_chunk
+inline size_t chunk_count(size_t count, size_t min_chunk) {
+  if (count == 0) {
+    return 0;
+  }
+  return std::clamp(count / std::max(min_chunk, size_t{1}), size_t{1},
+                    concurrency() == 1 ? 1 : concurrency() * 4);
+}
+
+// Calls body(chunk, first, last) for the chunks of [0, count)
+template <typename Body>
+void for_each_chunk(size_t count, size_t chunks, Body &&body) {
+  auto run = [&](size_t chunk) {
+    body(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+  };
+  if (chunks == 1) {
+    run(0);
+  } else if (chunks > 1) {
+    thread_pool::current()->for_each(chunks, run);
+  }
+}
+} // namespace detail
+
+// Calls f(i) for every i in [0, count), in chunks of at least min_chunk
+// indices
+template <typename F>
+void parallel_for(size_t count, F &&f, size_t min_chunk = 1) {
+  detail::for_each_chunk(count, detail::chunk_count(count, min_chunk),
+                         [&](size_t, size_t first, size_t last) {
+                           for (size_t i = first; i < last; ++i) {
+                             std::invoke(f, i);
+                           }
+                         });
+}
+
+// Calls f on every element of the range
+template <parallel_range R, typename F> void parallel_for(R &&range, F &&f) {
+  const auto first = std::ranges::begin(range);
+  parallel_for(std::ranges::size(range), [&](size_t i) {
+    std::invoke(f, first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+  });
+}
+
+// reduce(init, transform(e)...) over the elements e of the range. As with
+// std::transform_reduce, reduce must be associative and commutative.
+template <parallel_range R, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(R &&range, T init, Reduce reduce,
+                            Transform transform) {
+  const size_t count = std::ranges::size(range);
+  const size_t chunks = detail::chunk_count(count, 1);
+  const auto first = std::ranges::begin(range);
+  auto element = [&](size_t i) -> decltype(auto) {
+    return std::invoke(
+        transform, first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+  };
+
+  std::vector<std::optional<T>> partials(chunks);
+  detail::for_each_chunk(count, chunks, [&](size_t chunk, size_t from,
+                                            size_t to) {
+    T partial = element(from);
+    for (size_t i = from + 1; i < to; ++i) {
+      partial = std::invoke(reduce, std::move(partial), element(i));
+    }
+    partials[chunk] = std::move(partial);
+  });
+  for (std::optional<T> &partial : partials) {
+    init = std::invoke(reduce, std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+// Largest projection of the elements of the range, nullopt if it is empty
+template <parallel_range R, typename Proj = std::identity>
+auto parallel_max(R &&range, Proj proj = {}) {
+  using value_t = std::remove_cvref_t<
+      std::invoke_result_t<Proj &, std::ranges::range_reference_t<R>>>;
+  return parallel_transform_reduce(
+      range, std::optional<value_t>(),
+      [](std::optional<value_t> l, std::optional<value_t> r) {
+        return l && (!r || *r < *l) ? l : r;
+      },
+      [&proj](auto &&e) {
+        return std::optional<value_t>(
+            std::invoke(proj, std::forward<decltype(e)>(e)));
+      });
+}
+
+// Number of elements of the range satisfying pred
+template <parallel_range R, typename Pred>
+size_t parallel_count_if(R &&range, Pred pred) {
+  return parallel_transform_reduce(
+      range, size_t{0}, std::plus<>(), [&pred](auto &&e) -> size_t {
+        return std::invoke(pred, std::forward<decltype(e)>(e));
+      });
+}
+
+} // namespace aoc
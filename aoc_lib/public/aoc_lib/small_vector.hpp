@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace aoc {
+
+// Vector storing up to N elements inline, for the many tiny collections of
+// graph nodes. Past N elements it moves them to the heap like std::vector
+// does, and stays there. Any insertion may invalidate references and
+// iterators, as does moving an inline small_vector.
+template <typename T, size_t N> class small_vector {
+  static_assert(N > 0, "small_vector needs inline room for one element");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  small_vector() = default;
+
+  small_vector(std::initializer_list<T> init) {
+    reserve(init.size());
+    for (const T &v : init) {
+      push_back(v);
+    }
+  }
+
+  template <std::ranges::input_range R>
+  small_vector(std::from_range_t, R &&range) {
+    if constexpr (std::ranges::sized_range<R>) {
+      reserve(std::ranges::size(range));
+    }
+    for (auto &&v : range) {
+      emplace_back(std::forward<decltype(v)>(v));
+    }
+  }
+
+  small_vector(const small_vector &other) {
+    reserve(other.size());
+    std::uninitialized_copy(other.begin(), other.end(), m_data);
+    m_size = other.size();
+  }
+
+  small_vector(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    take(std::move(other));
+  }
+
+  small_vector &operator=(const small_vector &other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size());
+      std::uninitialized_copy(other.begin(), other.end(), m_data);
+      m_size = other.size();
+    }
+    return *this;
+  }
+
+  small_vector &operator=(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      release_heap();
+      take(std::move(other));
+    }
+    return *this;
+  }
+
+  ~small_vector() {
+    clear();
+    release_heap();
+  }
+
+  size_t size() const { return m_size; }
+  size_t capacity() const { return m_capacity; }
+  bool empty() const { return m_size == 0; }
+
+  // Whether the elements are stored inline
+  bool is_inline() const { return m_data == inline_data(); }
+
+  T *data() { return m_data; }
+  const T *data() const { return m_data; }
+
+  iterator begin() { return m_data; }
+  iterator end() { return m_data + m_size; }
+  const_iterator begin() const { return m_data; }
+  const_iterator end() const { return m_data + m_size; }
+
+  T &operator[](size_t i) { return m_data[i]; }
+  const T &operator[](size_t i) const { return m_data[i]; }
+
+  T &front() { return m_data[0]; }
+  const T &front() const { return m_data[0]; }
+  T &back() { return m_data[m_size - 1]; }
+  const T &back() const { return m_data[m_size - 1]; }
+
+  void reserve(size_t capacity) {
+    if (capacity > m_capacity) {
+      grow(capacity, [](T *) {});
+    }
+  }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (m_size == m_capacity) {
+      // The new element is built first, as args may refer to an element
+      grow(2 * m_capacity, [&](T *data) {
+        std::construct_at(data + m_size, std::forward<Args>(args)...);
+      });
+    } else {
+      std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    }
+    return m_data[m_size++];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() { std::destroy_at(m_data + --m_size); }
+
+  void clear() {
+    std::destroy(begin(), end());
+    m_size = 0;
+  }
+
+  bool operator==(const small_vector &other) const {
+    return std::ranges::equal(*this, other);
+  }
+
+private:
+  T *inline_data() { return reinterpret_cast<T *>(m_inline); }
+  const T *inline_data() const { return reinterpret_cast<const T *>(m_inline); }
+
+  // Moves the elements to a heap buffer of the given capacity, after calling
+  // before_move on it
+  template <typename F> void grow(size_t capacity, F &&before_move) {
+    T *data = std::allocator<T>{}.allocate(capacity);
+    try {
+      before_move(data);
+    } catch (...) {
+      std::allocator<T>{}.deallocate(data, capacity);
+      throw;
+    }
+    std::uninitialized_move(begin(), end(), data);
+    std::destroy(begin(), end());
+    release_heap();
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+  void release_heap() {
+    if (!is_inline()) {
+      std::allocator<T>{}.deallocate(m_data, m_capacity);
+      m_data = inline_data();
+      m_capacity = N;
+    }
+  }
+
+  // Takes the elements of other, which must be empty here
+  void take(small_vector &&other) {
+    if (other.is_inline()) {
+      std::uninitialized_move(other.begin(), other.end(), m_data);
+      m_size = other.m_size;
+      other.clear();
+    } else {
+      m_data = std::exchange(other.m_data, other.inline_data());
+      m_size = std::exchange(other.m_size, 0);
+      m_capacity = std::exchange(other.m_capacity, N);
+    }
+  }
+
+  alignas(T) std::byte m_inline[N * sizeof(T)];
+  T *m_data = inline_data();
+  size_t m_size = 0;
+  size_t m_capacity = N;
+};
+
+} // namespace aoc
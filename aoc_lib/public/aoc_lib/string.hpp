@@ -18,7 +18,7 @@ template <typename T> inline auto split(std::string_view src, T &&pattern) {
 inline auto lines(std::string_view src) {
   return split(src, '\n') | std::views::transform([](std::string_view line) {
            if (line.ends_with('\r')) {
-             line.remove_suffix('\r');
+             line.remove_suffix(1);
            }
            return line;
          });
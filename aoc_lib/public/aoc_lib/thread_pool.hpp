@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Fixed set of worker threads, each with its own queue of tasks. Workers take
+// tasks from the back of their queue and steal from the front of the others
+// once theirs is empty. Threads waiting on work run pending tasks meanwhile,
+// so that work can be nested without deadlocking.
+class thread_pool {
+public:
+  // concurrency - 1 workers are started: the thread handing out work also
+  // takes part in it. 0 means one thread per core.
+  explicit thread_pool(size_t concurrency = 0);
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  ~thread_pool();
+
+  // Number of threads working at once, including the calling one
+  size_t concurrency() const { return m_queues.size(); }
+
+  // Queues a task, which must not throw
+  void submit(std::move_only_function<void()> task);
+
+  // Runs one pending task on the calling thread, returns false if there was
+  // none
+  bool run_pending_task();
+
+  // Calls task(i) for every i in [0, count), spread over the threads of the
+  // pool, and returns once all calls are done. Indices are handed out one by
+  // one, so each call should be worth a few microseconds at least. The first
+  // exception thrown by a call is rethrown, remaining indices are skipped.
+  void for_each(size_t count, const std::function<void(size_t)> &task);
+
+  // Pool installed by thread_pool_scope, or nullptr if there is none
+  static thread_pool *current() { return s_current; }
+
+private:
+  friend class thread_pool_scope;
+
+  struct queue_t {
+    std::mutex mutex;
+    std::deque<std::move_only_function<void()>> tasks;
+  };
+
+  void work(size_t index, std::stop_token stop);
+  std::move_only_function<void()> take_task(size_t index);
+
+  // Queue 0 is shared by every thread outside of the pool
+  std::vector<std::unique_ptr<queue_t>> m_queues;
+  std::atomic<size_t> m_pending = 0;
+  std::mutex m_wake_mutex;
+  std::condition_variable_any m_wake;
+  std::vector<std::jthread> m_workers;
+
+  static thread_pool *s_current;
+};
+
+// Makes a pool the one used by the parallel algorithms for the lifetime of
+// the scope
+class thread_pool_scope {
+public:
+  explicit thread_pool_scope(thread_pool &pool)
+      : m_previous(std::exchange(thread_pool::s_current, &pool)) {}
+  thread_pool_scope(const thread_pool_scope &) = delete;
+  thread_pool_scope &operator=(const thread_pool_scope &) = delete;
+  ~thread_pool_scope() { thread_pool::s_current = m_previous; }
+
+private:
+  thread_pool *m_previous;
+};
+
+} // namespace aoc
@@ -0,0 +1,49 @@
+#include "aoc_lib/arena.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace aoc {
+
+arena::arena(size_t initial_chunk_size)
+    : m_next_chunk_size(initial_chunk_size) {}
+
+arena::~arena() { release(); }
+
+void arena::release() {
+  for (const chunk_t &chunk : m_chunks) {
+    ::operator delete(chunk.data, chunk.size);
+  }
+  m_chunks.clear();
+  m_current = nullptr;
+  m_remaining = 0;
+  m_allocated = 0;
+}
+
+void *arena::do_allocate(size_t bytes, size_t alignment) {
+  std::lock_guard lock(m_mutex);
+  void *p = m_current;
+  size_t space = m_remaining;
+  if (std::align(alignment, bytes, p, space) == nullptr) {
+    add_chunk(bytes + alignment);
+    p = m_current;
+    space = m_remaining;
+    std::align(alignment, bytes, p, space);
+  }
+  m_current = static_cast<std::byte *>(p) + bytes;
+  m_remaining = space - bytes;
+  m_allocated += bytes;
+  return p;
+}
+
+void arena::add_chunk(size_t min_size) {
+  const size_t size = std::max(m_next_chunk_size, min_size);
+  auto *data = static_cast<std::byte *>(::operator new(size));
+  m_chunks.push_back({data, size});
+  m_current = data;
+  m_remaining = size;
+  m_next_chunk_size = size * 2;
+}
+
+} // namespace aoc
@@ -0,0 +1,111 @@
+#include "aoc_lib/geometry/bit_matrix.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace aoc {
+
+size_t bit_matrix::count() const {
+  size_t res = 0;
+  for (word_t w : m_words) {
+    res += static_cast<size_t>(std::popcount(w));
+  }
+  return res;
+}
+
+bool bit_matrix::any() const {
+  return std::ranges::any_of(m_words, [](word_t w) { return w != 0; });
+}
+
+bit_matrix bit_matrix::shifted(ptrdiff_t dm, ptrdiff_t dn) const {
+  auto res = bit_matrix(m_width, m_height);
+  const auto height = static_cast<ptrdiff_t>(m_height);
+  const auto width = static_cast<ptrdiff_t>(m_width);
+  if (dm <= -height || dm >= height || dn <= -width || dn >= width) {
+    return res;
+  }
+
+  const size_t word_shift = static_cast<size_t>(dn < 0 ? -dn : dn) / word_bits;
+  const size_t bit_shift = static_cast<size_t>(dn < 0 ? -dn : dn) % word_bits;
+  const size_t words = m_words_per_row;
+  for (ptrdiff_t m = std::max(ptrdiff_t{}, dm);
+       m < std::min(height, height + dm); ++m) {
+    auto src = row(static_cast<size_t>(m - dm));
+    auto dst = res.row(static_cast<size_t>(m));
+    if (dn >= 0) {
+      // Towards higher columns, so towards the most significant bits
+      for (size_t i = words; i-- > word_shift;) {
+        word_t w = src[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift) {
+          w |= src[i - word_shift - 1] >> (word_bits - bit_shift);
+        }
+        dst[i] = w;
+      }
+    } else {
+      for (size_t i = 0; i + word_shift < words; ++i) {
+        word_t w = src[i + word_shift] >> bit_shift;
+        if (bit_shift != 0 && i + word_shift + 1 < words) {
+          w |= src[i + word_shift + 1] << (word_bits - bit_shift);
+        }
+        dst[i] = w;
+      }
+    }
+    dst.back() &= last_word_mask();
+  }
+  return res;
+}
+
+bool bit_matrix::intersects(const bit_matrix &r) const {
+  assert(m_width == r.m_width && m_height == r.m_height);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    if ((m_words[i] & r.m_words[i]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bit_matrix &bit_matrix::operator&=(const bit_matrix &r) {
+  assert(m_width == r.m_width && m_height == r.m_height);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] &= r.m_words[i];
+  }
+  return *this;
+}
+
+bit_matrix &bit_matrix::operator|=(const bit_matrix &r) {
+  assert(m_width == r.m_width && m_height == r.m_height);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] |= r.m_words[i];
+  }
+  return *this;
+}
+
+bit_matrix &bit_matrix::operator^=(const bit_matrix &r) {
+  assert(m_width == r.m_width && m_height == r.m_height);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] ^= r.m_words[i];
+  }
+  return *this;
+}
+
+bit_matrix bit_matrix::operator~() const {
+  auto res = *this;
+  for (word_t &w : res.m_words) {
+    w = ~w;
+  }
+  if (m_words_per_row > 0) {
+    for (size_t m = 0; m < m_height; ++m) {
+      res.row(m).back() &= last_word_mask();
+    }
+  }
+  return res;
+}
+
+bit_matrix::word_t bit_matrix::last_word_mask() const {
+  const size_t used = m_width % word_bits;
+  return used == 0 ? ~word_t{} : (word_t{1} << used) - 1;
+}
+
+} // namespace aoc
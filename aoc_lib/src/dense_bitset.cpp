@@ -0,0 +1,65 @@
+#include "aoc_lib/dense_bitset.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace aoc {
+
+void dense_bitset::clear() { std::ranges::fill(m_words, word_t{}); }
+
+size_t dense_bitset::count() const {
+  size_t res = 0;
+  for (word_t w : m_words) {
+    res += static_cast<size_t>(std::popcount(w));
+  }
+  return res;
+}
+
+bool dense_bitset::any() const {
+  return std::ranges::any_of(m_words, [](word_t w) { return w != 0; });
+}
+
+bool dense_bitset::intersects(const dense_bitset &r) const {
+  assert(m_size == r.m_size);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    if ((m_words[i] & r.m_words[i]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+dense_bitset &dense_bitset::operator&=(const dense_bitset &r) {
+  assert(m_size == r.m_size);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] &= r.m_words[i];
+  }
+  return *this;
+}
+
+dense_bitset &dense_bitset::operator|=(const dense_bitset &r) {
+  assert(m_size == r.m_size);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] |= r.m_words[i];
+  }
+  return *this;
+}
+
+dense_bitset &dense_bitset::operator^=(const dense_bitset &r) {
+  assert(m_size == r.m_size);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] ^= r.m_words[i];
+  }
+  return *this;
+}
+
+dense_bitset &dense_bitset::operator-=(const dense_bitset &r) {
+  assert(m_size == r.m_size);
+  for (size_t i = 0; i < m_words.size(); ++i) {
+    m_words[i] &= ~r.m_words[i];
+  }
+  return *this;
+}
+
+} // namespace aoc
@@ -0,0 +1,52 @@
+#include "aoc_lib/disjoint_set.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace aoc {
+
+disjoint_set::disjoint_set(size_t size)
+    : m_parents(size), m_sizes(size, 1), m_components(size) {
+  std::iota(m_parents.begin(), m_parents.end(), size_t{});
+}
+
+size_t disjoint_set::find(size_t i) {
+  while (m_parents[i] != i) {
+    m_parents[i] = m_parents[m_parents[i]];
+    i = m_parents[i];
+  }
+  return i;
+}
+
+bool disjoint_set::unite(size_t l, size_t r) {
+  l = find(l);
+  r = find(r);
+  if (l == r) {
+    return false;
+  }
+  if (m_sizes[l] < m_sizes[r]) {
+    std::swap(l, r);
+  }
+  m_parents[r] = l;
+  m_sizes[l] += m_sizes[r];
+  --m_components;
+  return true;
+}
+
+std::vector<size_t> disjoint_set::largest_components(size_t k) const {
+  std::vector<size_t> sizes;
+  sizes.reserve(m_components);
+  for (size_t i = 0; i < m_parents.size(); ++i) {
+    if (m_parents[i] == i) {
+      sizes.push_back(m_sizes[i]);
+    }
+  }
+  k = std::min(k, sizes.size());
+  std::ranges::partial_sort(sizes, sizes.begin() + k, std::greater{});
+  sizes.resize(k);
+  return sizes;
+}
+
+} // namespace aoc
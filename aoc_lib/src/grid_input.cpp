@@ -0,0 +1,72 @@
+#include "aoc_lib/geometry/grid_input.hpp"
+
+#include "aoc_lib/string.hpp"
+
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+namespace aoc {
+
+namespace {
+// Every row is converted straight into its slot of a single buffer. The
+// converters accumulate the validation instead of branching on it so that the
+// compiler can vectorise the whole row.
+template <typename Convert>
+dyn_matrix<uint8_t> parse_grid(std::string_view input, Convert &&convert) {
+  input = trimmed(input);
+
+  size_t width = 0;
+  size_t height = 0;
+  std::vector<uint8_t> cells;
+  cells.reserve(input.size());
+
+  for (std::string_view line : lines(input)) {
+    // As for the whole input, whitespace around a row is not part of the grid,
+    // so that indented or CRLF examples parse like the real inputs
+    line = trimmed(line);
+    if (height == 0) {
+      width = line.size();
+    } else if (line.size() != width) {
+      throw std::runtime_error(std::format(
+          "Grid row {} has width {}, expected {}", height, line.size(), width));
+    }
+    const size_t offset = cells.size();
+    cells.resize(offset + width);
+    if (!convert(line, cells.data() + offset)) {
+      throw std::runtime_error(std::format(
+          "Unexpected character in grid row {}: '{}'", height, line));
+    }
+    ++height;
+  }
+
+  return dyn_matrix<uint8_t>(width, height, std::move(cells));
+}
+} // namespace
+
+dyn_matrix<uint8_t> digit_grid(std::string_view input) {
+  return parse_grid(input, [](std::string_view line, uint8_t *out) {
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+      const auto digit = static_cast<uint8_t>(line[i] - '0');
+      out[i] = digit;
+      invalid |= static_cast<uint8_t>(digit > 9);
+    }
+    return invalid == 0;
+  });
+}
+
+dyn_matrix<uint8_t> char_grid(std::string_view input,
+                              const grid_alphabet &alphabet) {
+  return parse_grid(input, [&alphabet](std::string_view line, uint8_t *out) {
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+      const auto code = alphabet.code(line[i]);
+      out[i] = code;
+      invalid |= static_cast<uint8_t>(code == grid_alphabet::invalid);
+    }
+    return invalid == 0;
+  });
+}
+
+} // namespace aoc
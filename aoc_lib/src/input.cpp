@@ -41,6 +41,9 @@ arguments parse_arguments(int ac, const char **av, const char *app_name) {
       ->transform(CLI::CheckedTransformer(str_to_part, CLI::ignore_case));
   app.add_option("-x,--expected", output,
                  "File containing the expected output, used for testing");
+  app.add_option("-t,--threads", args.threads,
+                 "Number of threads to use, defaults to the number of cores")
+      ->check(CLI::PositiveNumber);
   try {
     app.parse(ac, av);
   } catch (const CLI::CallForHelp &) {
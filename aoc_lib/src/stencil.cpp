@@ -0,0 +1,99 @@
+#include "aoc_lib/geometry/stencil.hpp"
+
+#include <bit>
+#include <cassert>
+
+namespace aoc {
+
+namespace {
+using word_t = bit_matrix::word_t;
+constexpr size_t word_bits = bit_matrix::word_bits;
+
+// Word i of a row as seen dn columns away: its bit j is the cell of column
+// i * 64 + j + dn. Padding bits being cleared, cells past the end read as 0.
+word_t shifted_word(std::span<const word_t> row, size_t i, ptrdiff_t dn) {
+  if (dn > 0) {
+    const auto shift = static_cast<size_t>(dn);
+    word_t w = row[i] >> shift;
+    if (i + 1 < row.size()) {
+      w |= row[i + 1] << (word_bits - shift);
+    }
+    return w;
+  }
+  if (dn < 0) {
+    const auto shift = static_cast<size_t>(-dn);
+    word_t w = row[i] << shift;
+    if (i > 0) {
+      w |= row[i - 1] >> (word_bits - shift);
+    }
+    return w;
+  }
+  return row[i];
+}
+} // namespace
+
+void bit_stencil::step(std::span<const offset_t> offsets, count_rule rule) {
+  assert(offsets.size() < 32);
+  const size_t planes = static_cast<size_t>(std::bit_width(offsets.size()));
+  const auto height = static_cast<ptrdiff_t>(m_current.height());
+  const size_t used_bits = m_current.width() % word_bits;
+  const word_t last_word_mask =
+      used_bits == 0 ? ~word_t{} : (word_t{1} << used_bits) - 1;
+
+  auto step_row = [&](size_t m) {
+    const auto cells = m_current.row(m);
+    const auto next = m_next.row(m);
+    for (size_t i = 0; i < next.size(); ++i) {
+      std::array<word_t, 5> count{};
+      for (const offset_t &offset : offsets) {
+        assert(offset.dn > -ptrdiff_t{word_bits} &&
+               offset.dn < ptrdiff_t{word_bits});
+        const ptrdiff_t neighbour_m = static_cast<ptrdiff_t>(m) + offset.dm;
+        if (neighbour_m < 0 || neighbour_m >= height) {
+          continue;
+        }
+        // Ripple carry addition of one bit to every count
+        word_t carry = shifted_word(
+            m_current.row(static_cast<size_t>(neighbour_m)), i, offset.dn);
+        for (size_t p = 0; p < planes; ++p) {
+          const word_t overflow = count[p] & carry;
+          count[p] ^= carry;
+          carry = overflow;
+        }
+      }
+      word_t res = 0;
+      for (size_t k = 0; k <= offsets.size(); ++k) {
+        word_t matching = (((rule.born >> k) & 1) != 0 ? ~cells[i] : 0) |
+                          (((rule.survives >> k) & 1) != 0 ? cells[i] : 0);
+        for (size_t p = 0; p < planes && matching != 0; ++p) {
+          matching &= ((k >> p) & 1) != 0 ? count[p] : ~count[p];
+        }
+        res |= matching;
+      }
+      next[i] = res;
+    }
+    if (!next.empty()) {
+      next.back() &= last_word_mask;
+    }
+  };
+  // Smaller bands would cost more to hand out than to step
+  constexpr size_t min_band_words = 1024;
+  parallel_for(m_current.height(), step_row,
+               min_band_words /
+                   std::max(m_current.words_per_row(), size_t{1}));
+  std::swap(m_current, m_next);
+}
+
+void bit_stencil::step(adjacent_type::manhattan_t, count_rule rule) {
+  static constexpr offset_t offsets[] = {{-1, 0}, {0, -1}, {0, 1}, {1, 0}};
+  step(offsets, rule);
+}
+
+void bit_stencil::step(adjacent_type::euclidean_t, count_rule rule) {
+  static constexpr offset_t offsets[] = {{-1, -1}, {-1, 0}, {-1, 1},
+                                         {0, -1},  {0, 1},  {1, -1},
+                                         {1, 0},   {1, 1}};
+  step(offsets, rule);
+}
+
+} // namespace aoc
@@ -0,0 +1,138 @@
+#include "aoc_lib/thread_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace aoc {
+
+namespace {
+// Pool the current thread works for, and the index of its queue there
+thread_local const thread_pool *t_pool = nullptr;
+thread_local size_t t_index = 0;
+} // namespace
+
+thread_pool *thread_pool::s_current = nullptr;
+
+thread_pool::thread_pool(size_t concurrency) {
+  if (concurrency == 0) {
+    concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  m_queues.reserve(concurrency);
+  for (size_t i = 0; i < concurrency; ++i) {
+    m_queues.push_back(std::make_unique<queue_t>());
+  }
+  m_workers.reserve(concurrency - 1);
+  for (size_t i = 1; i < concurrency; ++i) {
+    m_workers.emplace_back(
+        [this, i](std::stop_token stop) { work(i, std::move(stop)); });
+  }
+}
+
+thread_pool::~thread_pool() {
+  // Stops and joins the workers before their queues go away
+  m_workers.clear();
+}
+
+void thread_pool::submit(std::move_only_function<void()> task) {
+  {
+    // Counted under the lock, so that no worker misses the wake up
+    std::lock_guard lock(m_wake_mutex);
+    ++m_pending;
+  }
+  queue_t &queue = *m_queues[t_pool == this ? t_index : 0];
+  {
+    std::lock_guard lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  m_wake.notify_one();
+}
+
+bool thread_pool::run_pending_task() {
+  auto task = take_task(t_pool == this ? t_index : 0);
+  if (!task) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void thread_pool::for_each(size_t count,
+                           const std::function<void(size_t)> &task) {
+  if (count == 0) {
+    return;
+  }
+  std::atomic<size_t> next = 0;
+  std::atomic<size_t> running_helpers = std::min(concurrency(), count) - 1;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  auto run = [&] {
+    size_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = count;
+      }
+    }
+  };
+  for (size_t helpers = running_helpers; helpers > 0; --helpers) {
+    submit([&] {
+      run();
+      running_helpers.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  run();
+  // Helpers still queued may be waiting for this very thread
+  while (running_helpers.load(std::memory_order_acquire) > 0) {
+    if (!run_pending_task()) {
+      std::this_thread::yield();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void thread_pool::work(size_t index, std::stop_token stop) {
+  t_pool = this;
+  t_index = index;
+  while (!stop.stop_requested()) {
+    if (auto task = take_task(index)) {
+      task();
+      continue;
+    }
+    std::unique_lock lock(m_wake_mutex);
+    m_wake.wait(lock, stop, [this] { return m_pending > 0; });
+  }
+}
+
+std::move_only_function<void()> thread_pool::take_task(size_t index) {
+  std::move_only_function<void()> task;
+  // Own tasks are taken last in, first out, as they are the most likely to
+  // still be in cache, and stolen ones first in, first out
+  for (size_t k = 0; k < m_queues.size() && !task; ++k) {
+    queue_t &queue = *m_queues[(index + k) % m_queues.size()];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (k == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+  }
+  if (task) {
+    --m_pending;
+  }
+  return task;
+}
+
+} // namespace aoc
@@ -0,0 +1,152 @@
+#include <aoc_lib/geometry/bit_matrix.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+constexpr size_t widths[] = {1, 7, 63, 64, 65, 127, 128, 130};
+
+aoc::bit_matrix random_matrix(size_t width, size_t height, std::mt19937 &rng) {
+  auto res = aoc::bit_matrix(width, height);
+  for (size_t m = 0; m < height; ++m) {
+    for (size_t n = 0; n < width; ++n) {
+      res.set(m, n, rng() % 2 == 0);
+    }
+  }
+  return res;
+}
+
+// Bits past the width in the last word of each row
+void expect_clear_padding(const aoc::bit_matrix &matrix) {
+  const size_t used = matrix.width() % aoc::bit_matrix::word_bits;
+  if (used == 0 || matrix.words_per_row() == 0) {
+    return;
+  }
+  for (size_t m = 0; m < matrix.height(); ++m) {
+    EXPECT_EQ(matrix.row(m).back() >> used, aoc::bit_matrix::word_t{})
+        << matrix.width() << " wide, row " << m;
+  }
+}
+
+} // namespace
+
+TEST(bit_matrix, set_and_flip) {
+  std::mt19937 rng(1);
+  for (size_t width : widths) {
+    auto matrix = aoc::bit_matrix(width, 3);
+    size_t expected = 0;
+    for (size_t i = 0; i < 200; ++i) {
+      const size_t m = rng() % 3;
+      const size_t n = rng() % width;
+      const bool was_set = matrix.at(m, n);
+      if (rng() % 2 == 0) {
+        matrix.flip(m, n);
+        expected = was_set ? expected - 1 : expected + 1;
+        EXPECT_NE(matrix.at(m, n), was_set);
+      } else {
+        const bool value = rng() % 2 == 0;
+        matrix.set(m, n, value);
+        expected = expected - was_set + value;
+        EXPECT_EQ(matrix.at(m, n), value);
+      }
+      ASSERT_EQ(matrix.count(), expected) << width;
+    }
+    expect_clear_padding(matrix);
+    EXPECT_EQ(matrix.any(), expected != 0);
+  }
+}
+
+// Shifts by less than, exactly and more than a word, both ways, checked cell
+// by cell
+TEST(bit_matrix, shifted) {
+  std::mt19937 rng(2);
+  for (size_t width : widths) {
+    const auto matrix = random_matrix(width, 5, rng);
+    for (ptrdiff_t dm : {-6, -2, 0, 1, 5}) {
+      for (ptrdiff_t dn : {-130, -70, -65, -64, -63, -5, -1, 0, 1, 3, 63, 64,
+                           65, 70, 129}) {
+        const auto res = matrix.shifted(dm, dn);
+        ASSERT_EQ(res.width(), width);
+        ASSERT_EQ(res.height(), size_t{5});
+        expect_clear_padding(res);
+        for (size_t m = 0; m < 5; ++m) {
+          for (size_t n = 0; n < width; ++n) {
+            const size_t from_m = m - static_cast<size_t>(dm);
+            const size_t from_n = n - static_cast<size_t>(dn);
+            const bool expected =
+                matrix.contains(from_m, from_n) && matrix.at(from_m, from_n);
+            ASSERT_EQ(res.at(m, n), expected)
+                << width << " wide, by " << dm << ", " << dn << " at " << m
+                << ", " << n;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(bit_matrix, complement) {
+  std::mt19937 rng(3);
+  for (size_t width : widths) {
+    const auto matrix = random_matrix(width, 4, rng);
+    const auto complement = ~matrix;
+    expect_clear_padding(complement);
+    EXPECT_EQ(matrix.count() + complement.count(), width * 4);
+    EXPECT_FALSE(matrix.intersects(complement));
+    EXPECT_EQ(~complement, matrix);
+
+    const auto full = ~aoc::bit_matrix(width, 4);
+    expect_clear_padding(full);
+    EXPECT_EQ(full.count(), width * 4);
+    // Padding bits shifted into the matrix would show up here
+    EXPECT_EQ(full.shifted(0, -1).count(), (width - 1) * 4);
+    EXPECT_EQ(full.shifted(1, 1).count(), (width - 1) * 3);
+  }
+}
+
+TEST(bit_matrix, operators) {
+  std::mt19937 rng(4);
+  for (size_t width : widths) {
+    const auto l = random_matrix(width, 4, rng);
+    const auto r = random_matrix(width, 4, rng);
+    const auto both = l & r;
+    const auto either = l | r;
+    const auto one = l ^ r;
+    for (size_t m = 0; m < 4; ++m) {
+      for (size_t n = 0; n < width; ++n) {
+        ASSERT_EQ(both.at(m, n), l.at(m, n) && r.at(m, n)) << width;
+        ASSERT_EQ(either.at(m, n), l.at(m, n) || r.at(m, n)) << width;
+        ASSERT_EQ(one.at(m, n), l.at(m, n) != r.at(m, n)) << width;
+      }
+    }
+    EXPECT_EQ(l.intersects(r), both.any());
+
+    auto assigned = l;
+    assigned &= r;
+    EXPECT_EQ(assigned, both);
+    assigned = l;
+    assigned |= r;
+    EXPECT_EQ(assigned, either);
+    assigned ^= r;
+    EXPECT_EQ(assigned, l & ~r);
+  }
+}
+
+TEST(bit_matrix, intersects) {
+  for (size_t width : widths) {
+    auto l = aoc::bit_matrix(width, 3);
+    auto r = aoc::bit_matrix(width, 3);
+    l.set(1, width - 1);
+    EXPECT_FALSE(l.intersects(r));
+    r.set(1, width - 1);
+    EXPECT_TRUE(l.intersects(r));
+    EXPECT_FALSE(l.intersects(r.shifted(1, 0)));
+    EXPECT_FALSE(l.intersects(r.shifted(0, 1)));
+    EXPECT_FALSE(l.intersects(r.shifted(0, -1)));
+    EXPECT_EQ(l.shifted(0, -1).intersects(r.shifted(0, -1)), width > 1);
+  }
+}
@@ -0,0 +1,88 @@
+#include <aoc_lib/geometry/fixed_matrix.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+namespace {
+
+// Small integers, so that floating point results are exact
+template <typename T, size_t M, size_t N>
+aoc::fixed_matrix<T, M, N> random_matrix(std::mt19937 &rng) {
+  std::array<T, M * N> values;
+  for (T &value : values) {
+    value = static_cast<T>(static_cast<int>(rng() % 101) - 50);
+  }
+  return aoc::fixed_matrix<T, M, N>(values);
+}
+
+template <size_t P, typename T, size_t M, size_t N>
+void check_product(const aoc::fixed_matrix<T, M, N> &l, std::mt19937 &rng) {
+  const auto r = random_matrix<T, N, P>(rng);
+  aoc::fixed_matrix<T, M, P> expected;
+  for (size_t m = 0; m < M; ++m) {
+    for (size_t p = 0; p < P; ++p) {
+      T dot{};
+      for (size_t n = 0; n < N; ++n) {
+        dot = static_cast<T>(dot + l.at(m, n) * r.at(n, p));
+      }
+      expected.at(m, p) = dot;
+    }
+  }
+  EXPECT_EQ((aoc::fixed_matrix<T, M, P>(l * r)), expected) << "times " << P;
+}
+
+// Compares the operators with plain loops over the cells
+template <typename T, size_t M, size_t N> void check_shape(std::mt19937 &rng) {
+  SCOPED_TRACE(testing::Message() << M << 'x' << N);
+  using matrix = aoc::fixed_matrix<T, M, N>;
+  for (size_t round = 0; round < 20; ++round) {
+    const auto l = random_matrix<T, M, N>(rng);
+    const auto r = random_matrix<T, M, N>(rng);
+    const auto factor = static_cast<T>(static_cast<int>(rng() % 11) - 5);
+
+    matrix sum, difference, scaled;
+    for (size_t m = 0; m < M; ++m) {
+      for (size_t n = 0; n < N; ++n) {
+        sum.at(m, n) = static_cast<T>(l.at(m, n) + r.at(m, n));
+        difference.at(m, n) = static_cast<T>(l.at(m, n) - r.at(m, n));
+        scaled.at(m, n) = static_cast<T>(l.at(m, n) * factor);
+      }
+    }
+
+    EXPECT_EQ(matrix(l + r), sum);
+    EXPECT_EQ(matrix(l - r), difference);
+    EXPECT_EQ(matrix(l * factor), scaled);
+    EXPECT_EQ(matrix(factor * l), scaled);
+
+    auto assigned = l;
+    EXPECT_EQ(&(assigned += r), &assigned);
+    EXPECT_EQ(assigned, sum);
+    assigned = l;
+    EXPECT_EQ(&(assigned -= r), &assigned);
+    EXPECT_EQ(assigned, difference);
+
+    [&]<size_t... P>(std::index_sequence<P...>) {
+      (check_product<P + 1>(l, rng), ...);
+    }(std::make_index_sequence<4>{});
+  }
+}
+
+template <typename T> class fixed_matrix_ops : public testing::Test {};
+
+using scalar_types = testing::Types<int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(fixed_matrix_ops, scalar_types);
+
+} // namespace
+
+// Every shape from 2x1 to 4x4
+TYPED_TEST(fixed_matrix_ops, against_loops) {
+  std::mt19937 rng(sizeof(TypeParam));
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (check_shape<TypeParam, I / 4 + 2, I % 4 + 1>(rng), ...);
+  }(std::make_index_sequence<12>{});
+}
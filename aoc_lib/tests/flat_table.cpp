@@ -0,0 +1,148 @@
+#include <aoc_lib/flat_map.hpp>
+#include <aoc_lib/flat_set.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Few distinct hashes, so that probe sequences are long and cross many
+// tombstones
+struct colliding_hash {
+  size_t operator()(uint32_t key) const { return key % 7; }
+};
+
+template <typename Map, typename Reference>
+void expect_same(const Map &map, const Reference &reference) {
+  ASSERT_EQ(map.size(), reference.size());
+  size_t visited = 0;
+  for (const auto &[key, value] : map) {
+    auto found = reference.find(key);
+    ASSERT_NE(found, reference.end()) << key;
+    EXPECT_EQ(value, found->second) << key;
+    ++visited;
+  }
+  EXPECT_EQ(visited, reference.size());
+}
+
+// Random inserts, erases and lookups of keys in [0, key_count), checked
+// against std::unordered_map after every operation
+template <typename Map> void random_operations(uint32_t key_count) {
+  std::mt19937 rng(key_count);
+  Map map;
+  std::unordered_map<uint32_t, uint64_t> reference;
+  for (size_t op = 0; op < 20000; ++op) {
+    const auto key = static_cast<uint32_t>(rng() % key_count);
+    switch (rng() % 6) {
+    case 0:
+    case 1: {
+      const uint64_t value = rng();
+      const bool inserted = map.try_emplace(key, value).second;
+      EXPECT_EQ(inserted, reference.try_emplace(key, value).second);
+      break;
+    }
+    case 2:
+      map[key] += 1;
+      reference[key] += 1;
+      break;
+    case 3:
+      EXPECT_EQ(map.erase(key), reference.erase(key));
+      break;
+    case 4:
+      if (auto found = map.find(key); found != map.end()) {
+        map.erase(found);
+        reference.erase(key);
+      }
+      break;
+    default:
+      EXPECT_EQ(map.contains(key), reference.contains(key));
+      break;
+    }
+    ASSERT_EQ(map.size(), reference.size());
+    if (op % 1000 == 0) {
+      expect_same(map, reference);
+    }
+  }
+  expect_same(map, reference);
+
+  const Map copy = map;
+  expect_same(copy, reference);
+  Map moved = std::move(map);
+  expect_same(moved, reference);
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(moved.begin(), moved.end());
+}
+
+} // namespace
+
+TEST(flat_map, random_operations) {
+  random_operations<aoc::flat_map<uint32_t, uint64_t>>(64);
+  random_operations<aoc::flat_map<uint32_t, uint64_t>>(5000);
+}
+
+TEST(flat_map, colliding_hashes) {
+  random_operations<aoc::flat_map<uint32_t, uint64_t, colliding_hash>>(300);
+}
+
+TEST(flat_map, growth) {
+  aoc::flat_map<uint32_t, uint32_t> map;
+  for (uint32_t i = 0; i < 100000; ++i) {
+    ASSERT_TRUE(map.try_emplace(i * 2654435761u, i).second);
+  }
+  ASSERT_EQ(map.size(), 100000);
+  for (uint32_t i = 0; i < 100000; ++i) {
+    ASSERT_EQ(map.at(i * 2654435761u), i);
+  }
+  EXPECT_FALSE(map.contains(1));
+}
+
+// Erasing everything and inserting again must reuse the tombstones rather
+// than grow the table
+TEST(flat_map, reinsert_after_erase) {
+  aoc::flat_map<uint32_t, uint32_t> map;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    map[i] = i;
+  }
+  const size_t capacity = map.capacity();
+  for (size_t round = 0; round < 50; ++round) {
+    for (uint32_t i = 0; i < 1000; ++i) {
+      ASSERT_EQ(map.erase(i), 1);
+    }
+    ASSERT_TRUE(map.empty());
+    for (uint32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(map.try_emplace(i, i).second);
+    }
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST(flat_set, random_strings) {
+  std::mt19937 rng(1);
+  aoc::flat_set<std::string> set;
+  std::unordered_set<std::string> reference;
+  for (size_t op = 0; op < 20000; ++op) {
+    const auto key = std::to_string(rng() % 2000);
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(set.erase(key), reference.erase(key));
+    } else {
+      EXPECT_EQ(set.insert(key).second, reference.insert(key).second);
+    }
+    ASSERT_EQ(set.size(), reference.size());
+  }
+  size_t visited = 0;
+  for (const std::string &key : set) {
+    EXPECT_TRUE(reference.contains(key)) << key;
+    ++visited;
+  }
+  EXPECT_EQ(visited, reference.size());
+}
@@ -0,0 +1,56 @@
+#include <aoc_lib/geometry/grid_input.hpp>
+#include <aoc_lib/string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+void expect_cells(const aoc::dyn_matrix<uint8_t> &grid,
+                  const std::vector<std::vector<uint8_t>> &expected) {
+  ASSERT_EQ(grid.height(), expected.size());
+  for (size_t m = 0; m < expected.size(); ++m) {
+    ASSERT_EQ(grid.width(), expected[m].size());
+    for (size_t n = 0; n < expected[m].size(); ++n) {
+      EXPECT_EQ(grid.at(m, n), expected[m][n]) << m << ", " << n;
+    }
+  }
+}
+
+} // namespace
+
+TEST(lines, crlf) {
+  std::vector<std::string_view> res;
+  for (std::string_view line : aoc::lines("ab\r\ncd\r\n\r\nef")) {
+    res.push_back(line);
+  }
+  EXPECT_EQ(res, (std::vector<std::string_view>{"ab", "cd", "", "ef"}));
+}
+
+TEST(digit_grid, line_endings_and_indentation) {
+  const std::vector<std::vector<uint8_t>> expected = {{1, 2, 3}, {4, 5, 6}};
+  expect_cells(aoc::digit_grid("123\n456\n"), expected);
+  expect_cells(aoc::digit_grid("123\r\n456\r\n"), expected);
+  expect_cells(aoc::digit_grid("\n  123\n  456  \n"), expected);
+}
+
+TEST(digit_grid, rejects_bad_rows) {
+  EXPECT_THROW(aoc::digit_grid("123\n45\n"), std::runtime_error);
+  EXPECT_THROW(aoc::digit_grid("123\n4a6\n"), std::runtime_error);
+  EXPECT_THROW(aoc::digit_grid("1 3\n456\n"), std::runtime_error);
+}
+
+TEST(char_grid, line_endings_and_indentation) {
+  constexpr auto alphabet = aoc::grid_alphabet(".#");
+  const std::vector<std::vector<uint8_t>> expected = {{0, 1}, {1, 0}};
+  expect_cells(aoc::char_grid(".#\n#.", alphabet), expected);
+  expect_cells(aoc::char_grid(".#\r\n#.\r\n", alphabet), expected);
+  expect_cells(aoc::char_grid("\t.#\n\t#.\n", alphabet), expected);
+  EXPECT_THROW(aoc::char_grid(".#\n#x\n", alphabet), std::runtime_error);
+}
@@ -0,0 +1,124 @@
+#include <aoc_lib/geometry/fixed_matrix.hpp>
+#include <aoc_lib/geometry/point.hpp>
+#include <aoc_lib/hash.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+constexpr size_t bucket_bits = 16;
+constexpr size_t buckets = size_t{1} << bucket_bits;
+
+struct occupancy {
+  size_t used = 0;
+  size_t largest = 0;
+};
+
+// Spreads the hashes over the buckets of a power of two table, either by
+// their low or by their high bits
+occupancy bucket_occupancy(const std::vector<size_t> &hashes, bool high_bits) {
+  auto loads = std::vector<size_t>(buckets);
+  for (size_t hash : hashes) {
+    const uint64_t h = hash;
+    ++loads[high_bits ? h >> (64 - bucket_bits) : h & (buckets - 1)];
+  }
+  return {.used = buckets - static_cast<size_t>(std::ranges::count(loads, 0)),
+          .largest = std::ranges::max(loads)};
+}
+
+// As many keys as buckets fill 1 - 1/e, about 63%, of them when the hashes
+// look random. Coordinates hashed without mixing fill far fewer.
+void expect_spread(const std::vector<size_t> &hashes) {
+  ASSERT_EQ(hashes.size(), buckets);
+  EXPECT_EQ(std::unordered_set<size_t>(hashes.begin(), hashes.end()).size(),
+            hashes.size());
+  for (bool high_bits : {false, true}) {
+    const occupancy res = bucket_occupancy(hashes, high_bits);
+    EXPECT_GT(res.used, buckets * 6 / 10) << "high bits: " << high_bits;
+    EXPECT_LE(res.largest, size_t{12}) << "high bits: " << high_bits;
+  }
+}
+
+} // namespace
+
+TEST(hash, dense_point_grid) {
+  std::vector<size_t> hashes;
+  for (int32_t y = -128; y < 128; ++y) {
+    for (int32_t x = -128; x < 128; ++x) {
+      hashes.push_back(std::hash<aoc::point2d<int32_t>>{}({x, y}));
+    }
+  }
+  expect_spread(hashes);
+}
+
+// 3 64 bits coordinates do not fit in two words, and go through the
+// accumulator instead
+TEST(hash, dense_point_grid_accumulated) {
+  std::vector<size_t> hashes;
+  for (int64_t z = 0; z < 16; ++z) {
+    for (int64_t y = 0; y < 64; ++y) {
+      for (int64_t x = 0; x < 64; ++x) {
+        hashes.push_back(std::hash<aoc::point3d<int64_t>>{}({x, y, z}));
+      }
+    }
+  }
+  expect_spread(hashes);
+}
+
+// Small integral matrices are hashed from their bytes with a single mix, the
+// others by accumulating the hashes of their cells
+TEST(hash, matrix_paths) {
+  using small_t = aoc::fixed_matrix<int16_t, 2, 3>;
+  using wide_t = aoc::fixed_matrix<int64_t, 3, 1>;
+  using floating_t = aoc::fixed_matrix<double, 2, 1>;
+
+  const auto small = small_t{1, -2, 3, -4, 5, -6};
+  uint64_t words[2] = {};
+  std::memcpy(words, &small.at(0, 0), sizeof(int16_t) * 6);
+  EXPECT_EQ(std::hash<small_t>{}(small),
+            aoc::hash_mix(words[0], words[1]));
+
+  const auto wide = wide_t{7, 8, 9};
+  const auto floating = floating_t{0.5, -1.5};
+  aoc::hash_accumulator wide_acc, floating_acc;
+  for (size_t m = 0; m < 3; ++m) {
+    wide_acc.accumulate(std::hash<int64_t>{}(wide.at(m, 0)));
+  }
+  for (size_t m = 0; m < 2; ++m) {
+    floating_acc.accumulate(std::hash<double>{}(floating.at(m, 0)));
+  }
+  EXPECT_EQ(std::hash<wide_t>{}(wide), wide_acc.result());
+  EXPECT_EQ(std::hash<floating_t>{}(floating), floating_acc.result());
+  EXPECT_EQ(aoc::hash_combine({std::hash<int64_t>{}(7),
+                               std::hash<int64_t>{}(8),
+                               std::hash<int64_t>{}(9)}),
+            wide_acc.result());
+}
+
+TEST(hash, order_matters) {
+  EXPECT_NE(aoc::hash_mix(1, 2), aoc::hash_mix(2, 1));
+  EXPECT_NE(aoc::hash_combine({1, 2}), aoc::hash_combine({2, 1}));
+  EXPECT_NE(std::hash<aoc::point2d<int32_t>>{}({1, 2}),
+            std::hash<aoc::point2d<int32_t>>{}({2, 1}));
+}
+
+// Flipping any single input bit changes about half of the output bits
+TEST(hash, avalanche) {
+  size_t flipped = 0;
+  for (uint64_t i = 0; i < 64; ++i) {
+    const size_t a = aoc::hash_mix(i * 0x9E3779B97F4A7C15ull, i);
+    const size_t b = aoc::hash_mix(i * 0x9E3779B97F4A7C15ull, i ^ (1ull << i));
+    flipped += static_cast<size_t>(std::popcount(a ^ b));
+  }
+  EXPECT_GT(flipped, size_t{64 * 24});
+  EXPECT_LT(flipped, size_t{64 * 40});
+}
@@ -0,0 +1,88 @@
+#include <aoc_lib/geometry/kd_tree.hpp>
+#include <aoc_lib/geometry/metric.hpp>
+#include <aoc_lib/geometry/point.hpp>
+#include <aoc_lib/geometry/point_array.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using point_t = aoc::point2d<uint32_t>;
+
+// Computed on signed coordinates, where the differences cannot wrap
+uint32_t reference_distance(aoc::metric::manhattan_t, const point_t &l,
+                            const point_t &r) {
+  uint32_t res = 0;
+  for (size_t d = 0; d < 2; ++d) {
+    const int64_t diff = int64_t{l[d]} - int64_t{r[d]};
+    res += static_cast<uint32_t>(diff < 0 ? -diff : diff);
+  }
+  return res;
+}
+
+uint32_t reference_distance(aoc::metric::squared_euclidean_t, const point_t &l,
+                            const point_t &r) {
+  uint32_t res = 0;
+  for (size_t d = 0; d < 2; ++d) {
+    const int64_t diff = int64_t{l[d]} - int64_t{r[d]};
+    res += static_cast<uint32_t>(diff * diff);
+  }
+  return res;
+}
+
+std::vector<point_t> random_points(size_t count, std::mt19937 &rng) {
+  std::vector<point_t> res;
+  for (size_t i = 0; i < count; ++i) {
+    res.push_back({static_cast<uint32_t>(rng() % 1000),
+                   static_cast<uint32_t>(rng() % 1000)});
+  }
+  return res;
+}
+
+template <aoc::distance_metric Metric> void check_unsigned(Metric metric) {
+  std::mt19937 rng(1);
+  const auto points = random_points(600, rng);
+  const auto array = aoc::point_array<uint32_t, 2>(std::from_range, points);
+  const auto tree = aoc::kd_tree<uint32_t, 2>(std::from_range, points);
+  auto dists = std::vector<uint32_t>(points.size());
+  for (const point_t &from : random_points(50, rng)) {
+    const uint32_t radius = std::is_same_v<Metric, aoc::metric::manhattan_t>
+                                ? 150
+                                : 150 * 150;
+    std::vector<uint32_t> expected;
+    std::vector<size_t> expected_within;
+    for (size_t i = 0; i < points.size(); ++i) {
+      expected.push_back(reference_distance(metric, from, points[i]));
+      EXPECT_EQ(aoc::distance(metric, from, points[i]), expected.back());
+      if (expected.back() <= radius) {
+        expected_within.push_back(i);
+      }
+    }
+
+    array.distances(from, metric, dists);
+    EXPECT_EQ(dists, expected);
+    EXPECT_EQ(array.count_within(from, radius, metric),
+              expected_within.size());
+
+    auto within = tree.within(from, radius, metric);
+    std::ranges::sort(within);
+    EXPECT_EQ(within, expected_within);
+    EXPECT_EQ(tree.nearest(from, 1, metric).front().second,
+              std::ranges::min(expected));
+  }
+}
+
+} // namespace
+
+// Differences of unsigned coordinates used to wrap around
+TEST(metric, unsigned_manhattan) { check_unsigned(aoc::metric::manhattan); }
+
+TEST(metric, unsigned_squared_euclidean) {
+  check_unsigned(aoc::metric::squared_euclidean);
+}
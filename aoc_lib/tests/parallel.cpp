@@ -0,0 +1,90 @@
+#include <aoc_lib/parallel.hpp>
+#include <aoc_lib/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t sizes[] = {0, 1, 2, 7, 64, 1000, 100003};
+
+std::vector<int64_t> random_values(size_t count) {
+  std::mt19937 rng(static_cast<std::mt19937::result_type>(count));
+  std::vector<int64_t> res(count);
+  for (int64_t &value : res) {
+    value = static_cast<int64_t>(rng() % 2000001) - 1000000;
+  }
+  return res;
+}
+
+void expect_like_ranges() {
+  for (size_t size : sizes) {
+    SCOPED_TRACE(testing::Message() << size << " values");
+    const auto values = random_values(size);
+    auto negated = [](int64_t v) { return -v; };
+    auto even = [](int64_t v) { return v % 2 == 0; };
+    auto positive = [](int64_t v) { return v > 0; };
+
+    const std::optional<int64_t> largest = aoc::parallel_max(values);
+    const std::optional<int64_t> smallest =
+        aoc::parallel_max(values, negated);
+    if (values.empty()) {
+      EXPECT_FALSE(largest);
+      EXPECT_FALSE(smallest);
+    } else {
+      EXPECT_EQ(largest, std::ranges::max(values));
+      EXPECT_EQ(smallest, -std::ranges::min(values));
+    }
+
+    EXPECT_EQ(aoc::parallel_count_if(values, even),
+              static_cast<size_t>(std::ranges::count_if(values, even)));
+    EXPECT_EQ(aoc::parallel_count_if(values, positive),
+              static_cast<size_t>(std::ranges::count_if(values, positive)));
+  }
+}
+
+} // namespace
+
+TEST(parallel, inline_without_pool) {
+  ASSERT_EQ(aoc::concurrency(), size_t{1});
+  expect_like_ranges();
+}
+
+TEST(parallel, thread_pool) {
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  ASSERT_EQ(aoc::concurrency(), size_t{4});
+  expect_like_ranges();
+}
+
+// The projection of parallel_max may return a type other than the elements
+TEST(parallel, max_projection) {
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 500; ++i) {
+    words.push_back(std::string(i * 7919 % 503, 'a'));
+  }
+  EXPECT_EQ(aoc::parallel_max(words, &std::string::size),
+            std::ranges::max(words, {}, &std::string::size).size());
+}
+
+TEST(parallel, for_visits_every_index_once) {
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  for (size_t size : sizes) {
+    std::vector<std::atomic<size_t>> visits(size);
+    aoc::parallel_for(size, [&](size_t i) { ++visits[i]; });
+    EXPECT_TRUE(std::ranges::all_of(
+        visits, [](const std::atomic<size_t> &v) { return v == 1; }))
+        << size;
+  }
+}
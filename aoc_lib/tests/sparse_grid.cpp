@@ -0,0 +1,92 @@
+#include <aoc_lib/geometry/sparse_grid.hpp>
+#include <aoc_lib/parallel.hpp>
+#include <aoc_lib/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <ranges>
+#include <utility>
+
+namespace {
+
+using grid_t = aoc::sparse_grid<int32_t, 8>;
+using point_t = grid_t::point_t;
+
+// Random writes around the origin, negative coordinates included
+std::pair<grid_t, std::map<std::pair<int64_t, int64_t>, int32_t>>
+random_grid(std::mt19937 &rng) {
+  auto grid = grid_t(-1);
+  std::map<std::pair<int64_t, int64_t>, int32_t> reference;
+  for (size_t i = 0; i < 2000; ++i) {
+    const auto x = static_cast<int64_t>(rng() % 60) - 30;
+    const auto y = static_cast<int64_t>(rng() % 60) - 30;
+    const auto value = static_cast<int32_t>(rng() % 1000);
+    grid.set({x, y}, value);
+    reference[{x, y}] = value;
+  }
+  return {std::move(grid), std::move(reference)};
+}
+
+int32_t expected_at(const std::map<std::pair<int64_t, int64_t>, int32_t> &ref,
+                    int64_t x, int64_t y) {
+  const auto found = ref.find({x, y});
+  return found != ref.end() ? found->second : -1;
+}
+
+} // namespace
+
+TEST(sparse_grid, get) {
+  std::mt19937 rng(1);
+  auto [grid, reference] = random_grid(rng);
+  const grid_t &const_grid = grid;
+  for (int64_t y = -40; y < 40; ++y) {
+    for (int64_t x = -40; x < 40; ++x) {
+      ASSERT_EQ(const_grid.get({x, y}), expected_at(reference, x, y))
+          << x << ", " << y;
+      ASSERT_EQ(grid.get({x, y}), expected_at(reference, x, y))
+          << x << ", " << y;
+    }
+  }
+}
+
+// Every cell of the 3x3 tiles around the center is read through the view
+TEST(sparse_grid, neighbourhood) {
+  std::mt19937 rng(2);
+  const auto [grid, reference] = random_grid(rng);
+  for (const point_t center :
+       {point_t{0, 0}, point_t{-9, 17}, point_t{-30, -30}, point_t{100, 100}}) {
+    const auto view = grid.neighbourhood(center);
+    const int64_t tile_x = (center.x() >> 3) * 8;
+    const int64_t tile_y = (center.y() >> 3) * 8;
+    for (int64_t y = tile_y - 8; y < tile_y + 16; ++y) {
+      for (int64_t x = tile_x - 8; x < tile_x + 16; ++x) {
+        ASSERT_EQ(view.get({x, y}), expected_at(reference, x, y))
+            << x << ", " << y;
+      }
+    }
+  }
+}
+
+// Threads reading a shared const grid must not race, which ThreadSanitizer
+// checks
+TEST(sparse_grid, concurrent_const_reads) {
+  std::mt19937 rng(3);
+  const auto [grid, reference] = random_grid(rng);
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  const size_t mismatches = aoc::parallel_count_if(
+      std::views::iota(int64_t{0}, int64_t{8000}), [&](int64_t row) {
+        const int64_t y = row % 80 - 40;
+        for (int64_t x = -40; x < 40; ++x) {
+          if (grid.get({x, y}) != expected_at(reference, x, y)) {
+            return true;
+          }
+        }
+        return false;
+      });
+  EXPECT_EQ(mismatches, size_t{0});
+}
@@ -0,0 +1,118 @@
+#include <aoc_lib/geometry/bit_matrix.hpp>
+#include <aoc_lib/geometry/stencil.hpp>
+#include <aoc_lib/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+
+namespace {
+
+using offset_t = aoc::bit_stencil::offset_t;
+
+aoc::bit_matrix random_matrix(size_t width, size_t height, std::mt19937 &rng) {
+  auto res = aoc::bit_matrix(width, height);
+  for (size_t m = 0; m < height; ++m) {
+    for (size_t n = 0; n < width; ++n) {
+      res.set(m, n, rng() % 3 == 0);
+    }
+  }
+  return res;
+}
+
+// One step computed a cell at a time
+aoc::bit_matrix reference_step(const aoc::bit_matrix &grid,
+                               std::span<const offset_t> offsets,
+                               aoc::count_rule rule) {
+  auto res = aoc::bit_matrix(grid.width(), grid.height());
+  for (size_t m = 0; m < grid.height(); ++m) {
+    for (size_t n = 0; n < grid.width(); ++n) {
+      size_t count = 0;
+      for (const offset_t &offset : offsets) {
+        const size_t nm = m + static_cast<size_t>(offset.dm);
+        const size_t nn = n + static_cast<size_t>(offset.dn);
+        count += grid.contains(nm, nn) && grid[nm, nn];
+      }
+      const uint32_t rule_bits = grid[m, n] ? rule.survives : rule.born;
+      res.set(m, n, ((rule_bits >> count) & 1) != 0);
+    }
+  }
+  return res;
+}
+
+void expect_steps_match(std::span<const offset_t> offsets,
+                        aoc::count_rule rule) {
+  std::mt19937 rng(static_cast<std::mt19937::result_type>(offsets.size()));
+  for (size_t width : {1, 5, 63, 64, 65, 130}) {
+    for (size_t height : {1, 3, 40}) {
+      auto expected = random_matrix(width, height, rng);
+      auto stencil = aoc::bit_stencil(expected);
+      for (size_t i = 0; i < 4; ++i) {
+        expected = reference_step(expected, offsets, rule);
+        stencil.step(offsets, rule);
+        ASSERT_EQ(stencil.grid(), expected)
+            << width << 'x' << height << ", step " << i;
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST(bit_stencil, life) {
+  static constexpr offset_t euclidean[] = {{-1, -1}, {-1, 0}, {-1, 1},
+                                           {0, -1},  {0, 1},  {1, -1},
+                                           {1, 0},   {1, 1}};
+  const auto life = aoc::count_rule{.born = 0b1000, .survives = 0b1100};
+  expect_steps_match(euclidean, life);
+
+  std::mt19937 rng(1);
+  const auto grid = random_matrix(100, 100, rng);
+  auto stencil = aoc::bit_stencil(grid);
+  stencil.step(aoc::adjacent_type::euclidean, life);
+  EXPECT_EQ(stencil.grid(), reference_step(grid, euclidean, life));
+}
+
+TEST(bit_stencil, manhattan) {
+  static constexpr offset_t manhattan[] = {{-1, 0}, {0, -1}, {0, 1}, {1, 0}};
+  const auto rule = aoc::count_rule{.born = 0b00110, .survives = 0b10101};
+  expect_steps_match(manhattan, rule);
+
+  std::mt19937 rng(2);
+  const auto grid = random_matrix(70, 20, rng);
+  auto stencil = aoc::bit_stencil(grid);
+  stencil.step(aoc::adjacent_type::manhattan, rule);
+  EXPECT_EQ(stencil.grid(), reference_step(grid, manhattan, rule));
+}
+
+// Neighbours far enough to cross word boundaries, counting up to 16
+TEST(bit_stencil, wide_neighbourhood) {
+  offset_t offsets[16];
+  for (ptrdiff_t i = 0; i < 8; ++i) {
+    offsets[2 * i] = {i % 3 - 1, 8 * i - 63};
+    offsets[2 * i + 1] = {1 - i % 3, 63 - 9 * i};
+  }
+  const auto rule = aoc::count_rule{.born = 0x1'2348, .survives = 0x1'8421};
+  expect_steps_match(offsets, rule);
+}
+
+TEST(bit_stencil, thread_pool) {
+  static constexpr offset_t euclidean[] = {{-1, -1}, {-1, 0}, {-1, 1},
+                                           {0, -1},  {0, 1},  {1, -1},
+                                           {1, 0},   {1, 1}};
+  const auto life = aoc::count_rule{.born = 0b1000, .survives = 0b1100};
+  std::mt19937 rng(3);
+  auto expected = random_matrix(300, 500, rng);
+  auto stencil = aoc::bit_stencil(expected);
+
+  aoc::thread_pool pool(4);
+  aoc::thread_pool_scope pool_scope(pool);
+  for (size_t i = 0; i < 3; ++i) {
+    expected = reference_step(expected, euclidean, life);
+    stencil.step(aoc::adjacent_type::euclidean, life);
+    ASSERT_EQ(stencil.grid(), expected) << "step " << i;
+  }
+}